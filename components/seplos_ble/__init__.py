@@ -0,0 +1,4 @@
+CODEOWNERS = ["@syssi"]
+
+# Helpers shared by the Seplos BLE components: the ByteView frame view and the local ATT MTU,
+# a setting of the Bluetooth stack which all BLE clients of the node share
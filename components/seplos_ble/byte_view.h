@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome::seplos_ble {
+
+// Non-owning view of a received frame or a part of it
+class ByteView {
+ public:
+  ByteView() = default;
+  ByteView(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+  ByteView(const std::vector<uint8_t> &data) : data_(data.data()), size_(data.size()) {}  // NOLINT
+
+  const uint8_t *data() const { return this->data_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  const uint8_t &operator[](size_t i) const { return this->data_[i]; }
+  const uint8_t &front() const { return this->data_[0]; }
+  const uint8_t *begin() const { return this->data_; }
+  const uint8_t *end() const { return this->data_ + this->size_; }
+  ByteView subview(size_t offset, size_t length) const { return {this->data_ + offset, length}; }
+
+ protected:
+  const uint8_t *data_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace esphome::seplos_ble
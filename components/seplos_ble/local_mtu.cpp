@@ -0,0 +1,36 @@
+#include "local_mtu.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+
+#ifdef USE_ESP32
+#include <esp_gatt_common_api.h>
+#endif
+
+namespace esphome::seplos_ble {
+
+static const char *const TAG = "seplos_ble";
+
+static uint16_t requested_local_mtu = 0;
+static bool local_mtu_applied = false;
+
+void request_local_mtu(uint16_t mtu) { requested_local_mtu = std::max(requested_local_mtu, mtu); }
+
+void apply_local_mtu() {
+  if (local_mtu_applied || requested_local_mtu == 0)
+    return;
+  local_mtu_applied = true;
+
+#ifdef USE_ESP32
+  auto status = esp_ble_gatt_set_local_mtu(requested_local_mtu);
+  if (status) {
+    ESP_LOGW(TAG, "esp_ble_gatt_set_local_mtu failed, status=%d", status);
+    return;
+  }
+#endif
+  ESP_LOGD(TAG, "Local ATT MTU set to %u for all BLE clients", requested_local_mtu);
+}
+
+uint16_t get_local_mtu() { return requested_local_mtu; }
+
+}  // namespace esphome::seplos_ble
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome::seplos_ble {
+
+// The local ATT MTU is a setting of the Bluetooth stack and applies to every BLE client of the node,
+// not to a single connection. Each component registers the MTU it wants at configuration time and the
+// largest one is handed to the stack once, by the first component set up
+void request_local_mtu(uint16_t mtu);
+void apply_local_mtu();
+uint16_t get_local_mtu();
+
+}  // namespace esphome::seplos_ble
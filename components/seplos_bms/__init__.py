@@ -9,6 +9,8 @@ MULTI_CONF = True
 
 CONF_SEPLOS_BMS_ID = "seplos_bms_id"
 CONF_OVERRIDE_CELL_COUNT = "override_cell_count"
+CONF_ALARM_UPDATE_INTERVAL = "alarm_update_interval"
+CONF_ALL_PACKS_SOURCE_ID = "all_packs_source_id"
 
 DEFAULT_PROTOCOL_VERSION = 0x20
 DEFAULT_ADDRESS = 0x00
@@ -32,6 +34,10 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_OVERRIDE_CELL_COUNT, default=0): cv.int_range(
                 min=0, max=16
             ),
+            cv.Optional(
+                CONF_ALARM_UPDATE_INTERVAL, default="1s"
+            ): cv.update_interval,
+            cv.Optional(CONF_ALL_PACKS_SOURCE_ID): cv.use_id(SeplosBms),
         }
     )
     .extend(cv.polling_component_schema("10s"))
@@ -49,3 +55,7 @@ async def to_code(config):
     await seplos_modbus.register_seplos_modbus_device(var, config)
 
     cg.add(var.set_override_cell_count(config[CONF_OVERRIDE_CELL_COUNT]))
+    cg.add(var.set_alarm_update_interval(config[CONF_ALARM_UPDATE_INTERVAL]))
+    if CONF_ALL_PACKS_SOURCE_ID in config:
+        source = await cg.get_variable(config[CONF_ALL_PACKS_SOURCE_ID])
+        cg.add(var.set_all_packs_source(source))
@@ -1,7 +1,11 @@
 import esphome.codegen as cg
 from esphome.components import binary_sensor
 import esphome.config_validation as cv
-from esphome.const import DEVICE_CLASS_CONNECTIVITY, ENTITY_CATEGORY_DIAGNOSTIC
+from esphome.const import (
+    DEVICE_CLASS_CONNECTIVITY,
+    DEVICE_CLASS_PROBLEM,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+)
 
 from . import CONF_SEPLOS_BMS_ID, SEPLOS_BMS_COMPONENT_SCHEMA
 
@@ -10,6 +14,9 @@ DEPENDENCIES = ["seplos_bms"]
 CODEOWNERS = ["@syssi"]
 
 CONF_ONLINE_STATUS = "online_status"
+CONF_VOLTAGE_PROTECTION = "voltage_protection"
+CONF_TEMPERATURE_PROTECTION = "temperature_protection"
+CONF_CURRENT_PROTECTION = "current_protection"
 
 # key: binary_sensor_schema kwargs
 BINARY_SENSOR_DEFS = {
@@ -17,6 +24,21 @@ BINARY_SENSOR_DEFS = {
         "device_class": DEVICE_CLASS_CONNECTIVITY,
         "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
     },
+    CONF_VOLTAGE_PROTECTION: {
+        "icon": "mdi:flash-alert",
+        "device_class": DEVICE_CLASS_PROBLEM,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_TEMPERATURE_PROTECTION: {
+        "icon": "mdi:thermometer-alert",
+        "device_class": DEVICE_CLASS_PROBLEM,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_CURRENT_PROTECTION: {
+        "icon": "mdi:current-ac",
+        "device_class": DEVICE_CLASS_PROBLEM,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
 }
 
 CONFIG_SCHEMA = SEPLOS_BMS_COMPONENT_SCHEMA.extend(
@@ -10,6 +10,7 @@ from esphome.const import (
     DEVICE_CLASS_POWER,
     DEVICE_CLASS_TEMPERATURE,
     DEVICE_CLASS_VOLTAGE,
+    ENTITY_CATEGORY_DIAGNOSTIC,
     ICON_EMPTY,
     STATE_CLASS_MEASUREMENT,
     STATE_CLASS_TOTAL_INCREASING,
@@ -46,6 +47,16 @@ CONF_RATED_CAPACITY = "rated_capacity"
 CONF_CHARGING_CYCLES = "charging_cycles"
 CONF_STATE_OF_HEALTH = "state_of_health"
 CONF_PORT_VOLTAGE = "port_voltage"
+CONF_CELL_VOLTAGE_ALARM_BITMASK = "cell_voltage_alarm_bitmask"
+CONF_TEMPERATURE_ALARM_BITMASK = "temperature_alarm_bitmask"
+CONF_ALARM_EVENT1_BITMASK = "alarm_event1_bitmask"
+CONF_ALARM_EVENT2_BITMASK = "alarm_event2_bitmask"
+CONF_ALARM_EVENT3_BITMASK = "alarm_event3_bitmask"
+CONF_ALARM_EVENT4_BITMASK = "alarm_event4_bitmask"
+CONF_ALARM_EVENT5_BITMASK = "alarm_event5_bitmask"
+CONF_ALARM_EVENT6_BITMASK = "alarm_event6_bitmask"
+CONF_ALARM_EVENT7_BITMASK = "alarm_event7_bitmask"
+CONF_ALARM_EVENT8_BITMASK = "alarm_event8_bitmask"
 
 ICON_CURRENT_DC = "mdi:current-dc"
 ICON_MIN_VOLTAGE_CELL = "mdi:battery-minus-outline"
@@ -57,6 +68,17 @@ ICON_RATED_CAPACITY = "mdi:battery-50"
 ICON_CHARGING_CYCLES = "mdi:battery-sync"
 ICON_STATE_OF_HEALTH = "mdi:heart-flash"
 
+ICON_CELL_VOLTAGE_ALARM_BITMASK = "mdi:battery-alert"
+ICON_TEMPERATURE_ALARM_BITMASK = "mdi:thermometer-alert"
+ICON_ALARM_EVENT1_BITMASK = "mdi:alert-octagon-outline"
+ICON_ALARM_EVENT2_BITMASK = "mdi:alert-octagon-outline"
+ICON_ALARM_EVENT3_BITMASK = "mdi:thermometer-alert"
+ICON_ALARM_EVENT4_BITMASK = "mdi:thermometer-alert"
+ICON_ALARM_EVENT5_BITMASK = "mdi:current-ac"
+ICON_ALARM_EVENT6_BITMASK = "mdi:battery-alert"
+ICON_ALARM_EVENT7_BITMASK = "mdi:alert-circle-outline"
+ICON_ALARM_EVENT8_BITMASK = "mdi:alert-circle-outline"
+
 UNIT_AMPERE_HOURS = "Ah"
 
 CELLS = [f"cell_voltage_{i}" for i in range(1, 17)]
@@ -189,6 +211,76 @@ SENSOR_DEFS = {
         "device_class": DEVICE_CLASS_VOLTAGE,
         "state_class": STATE_CLASS_MEASUREMENT,
     },
+    CONF_CELL_VOLTAGE_ALARM_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_CELL_VOLTAGE_ALARM_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_TEMPERATURE_ALARM_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_TEMPERATURE_ALARM_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_ALARM_EVENT1_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_ALARM_EVENT1_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_ALARM_EVENT2_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_ALARM_EVENT2_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_ALARM_EVENT3_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_ALARM_EVENT3_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_ALARM_EVENT4_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_ALARM_EVENT4_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_ALARM_EVENT5_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_ALARM_EVENT5_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_ALARM_EVENT6_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_ALARM_EVENT6_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_ALARM_EVENT7_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_ALARM_EVENT7_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
+    CONF_ALARM_EVENT8_BITMASK: {
+        "unit_of_measurement": UNIT_EMPTY,
+        "icon": ICON_ALARM_EVENT8_BITMASK,
+        "accuracy_decimals": 0,
+        "device_class": DEVICE_CLASS_EMPTY,
+        "entity_category": ENTITY_CATEGORY_DIAGNOSTIC,
+    },
 }
 
 _CELL_VOLTAGE_SCHEMA = sensor.sensor_schema(
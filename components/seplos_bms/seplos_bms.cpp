@@ -1,6 +1,8 @@
 #include "seplos_bms.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include <cinttypes>
+#include <cstring>
 
 namespace esphome::seplos_bms {
 
@@ -8,30 +10,220 @@ static const char *const TAG = "seplos_bms";
 
 static const uint8_t MAX_NO_RESPONSE_COUNT = 5;
 
-void SeplosBms::on_seplos_modbus_data(const std::vector<uint8_t> &data) {
+static const uint8_t SEPLOS_CMD_TELEMETRY = 0x42;
+static const uint8_t SEPLOS_CMD_ALARMS = 0x44;
+static const uint8_t SEPLOS_CMD_PROTOCOL_VERSION = 0x4F;
+static const uint8_t SEPLOS_CMD_MANUFACTURER_INFO = 0x51;
+
+// Command value (pack) requesting the telemetry of every pack of the stack
+static const uint8_t SEPLOS_ALL_PACKS = 0xFF;
+
+static constexpr const char *const ALARM_EVENT1_MESSAGES[8] = {
+    "Voltage sensing failure",      // Bit 0
+    "Temperature sensing failure",  // Bit 1
+    "Current sensing failure",      // Bit 2
+    "Key switch failure",           // Bit 3
+    "Cell voltage diff failure",    // Bit 4
+    "Charging switch failure",      // Bit 5
+    "Discharge switch failure",     // Bit 6
+    "Current limit switch failure"  // Bit 7
+};
+
+static constexpr const char *const ALARM_EVENT2_MESSAGES[8] = {
+    "Single high voltage alarm",       // Bit 0
+    "Single overvoltage protection",   // Bit 1
+    "Single low voltage alarm",        // Bit 2
+    "Single undervoltage protection",  // Bit 3
+    "Total high voltage alarm",        // Bit 4
+    "Total overvoltage protection",    // Bit 5
+    "Total low voltage alarm",         // Bit 6
+    "Total undervoltage protection"    // Bit 7
+};
+
+static constexpr const char *const ALARM_EVENT3_MESSAGES[8] = {
+    "Charging high temp alarm",       // Bit 0
+    "Charging overtemp protection",   // Bit 1
+    "Charging low temp alarm",        // Bit 2
+    "Charging undertemp protection",  // Bit 3
+    "Discharge high temp alarm",      // Bit 4
+    "Discharge overtemp protection",  // Bit 5
+    "Discharge low temp alarm",       // Bit 6
+    "Discharge undertemp protection"  // Bit 7
+};
+
+static constexpr const char *const ALARM_EVENT4_MESSAGES[8] = {
+    "Ambient high temp alarm",       // Bit 0
+    "Ambient overtemp protection",   // Bit 1
+    "Ambient low temp alarm",        // Bit 2
+    "Ambient undertemp protection",  // Bit 3
+    "Power overtemp protection",     // Bit 4
+    "Power high temp alarm",         // Bit 5
+    "Battery low temp heating",      // Bit 6
+    "Secondary trip protection"      // Bit 7
+};
+
+static constexpr const char *const ALARM_EVENT5_MESSAGES[8] = {
+    "Charging overcurrent alarm",        // Bit 0
+    "Charging overcurrent protection",   // Bit 1
+    "Discharge overcurrent alarm",       // Bit 2
+    "Discharge overcurrent protection",  // Bit 3
+    "Transient overcurrent protection",  // Bit 4
+    "Output short circuit protection",   // Bit 5
+    "Transient overcurrent lockout",     // Bit 6
+    "Output short circuit lockout"       // Bit 7
+};
+
+static constexpr const char *const ALARM_EVENT6_MESSAGES[8] = {
+    "Charging high voltage protection",    // Bit 0
+    "Intermittent power replenishment",    // Bit 1
+    "Remaining capacity alarm",            // Bit 2
+    "Remaining capacity protection",       // Bit 3
+    "Low voltage charging prohibited",     // Bit 4
+    "Output reverse polarity protection",  // Bit 5
+    "Output connection failure",           // Bit 6
+    "Internal alarm"                       // Bit 7
+};
+
+static constexpr const char *const ALARM_EVENT7_MESSAGES[8] = {
+    "Internal alarm 1",            // Bit 0
+    "Internal alarm 2",            // Bit 1
+    "Internal alarm 3",            // Bit 2
+    "Internal alarm 4",            // Bit 3
+    "Automatic charging waiting",  // Bit 4
+    "Manual charging waiting",     // Bit 5
+    "Internal alarm 6",            // Bit 6
+    "Internal alarm 7"             // Bit 7
+};
+
+static constexpr const char *const ALARM_EVENT8_MESSAGES[8] = {
+    "EEP storage failure",              // Bit 0
+    "RTC clock failure",                // Bit 1
+    "Voltage calibration not done",     // Bit 2
+    "Current calibration not done",     // Bit 3
+    "Zero point calibration not done",  // Bit 4
+    "Calendar not synchronized",        // Bit 5
+    "Internal system error 6",          // Bit 6
+    "Internal system error 7"           // Bit 7
+};
+
+static const char *alarm_state_to_string(uint8_t state) {
+  switch (state) {
+    case 0x01:
+      return "below lower limit";
+    case 0x02:
+      return "above upper limit";
+    default:
+      return "other error";
+  }
+}
+
+static void append_alarm(std::string &alarms, const std::string &alarm) {
+  if (!alarms.empty()) {
+    alarms.append(";");
+  }
+  alarms.append(alarm);
+}
+
+static std::string trimmed_string(const uint8_t *data, uint8_t length) {
+  while (length > 0 && (data[length - 1] == ' ' || data[length - 1] == 0x00)) {
+    length--;
+  }
+  return std::string(data, data + length);
+}
+
+// Returns the size of the pack record starting at offset or 0 if the record is truncated
+static uint16_t telemetry_record_length(const uint8_t *data, uint16_t length, uint16_t offset) {
+  // Number of cells + cell voltages
+  uint16_t pos = offset;
+  if (pos >= length)
+    return 0;
+  pos = pos + 1 + data[pos] * 2;
+
+  // Number of temperatures + temperatures, current, total voltage, residual capacity
+  if (pos >= length)
+    return 0;
+  pos = pos + 1 + data[pos] * 2 + 6;
+
+  // Custom number + custom values
+  if (pos >= length)
+    return 0;
+  pos = pos + 1 + data[pos] * 2;
+
+  return (pos <= length) ? pos - offset : 0;
+}
+
+void SeplosBms::setup() {
+  // Every command class is polled at its own rate: telemetry on update(), alarms fast and the static device
+  // information once per boot. The alarm frame carries no pack records, so packs fed by an all-packs source
+  // still request their alarms at their own address
+  this->set_interval("alarms", this->alarm_update_interval_, [this]() { this->send(SEPLOS_CMD_ALARMS, this->pack_); });
+}
+
+void SeplosBms::on_seplos_modbus_data(uint8_t function, const uint8_t *data, uint16_t length) {
+  // Pack records are handed over by the all-packs source. Alarms and the device information are requested by
+  // the pack itself
+  if (this->all_packs_source_ != nullptr && function == SEPLOS_CMD_TELEMETRY)
+    return;
+
+  // Late or unsolicited frames can't be told apart by their layout: an alarm frame also carries the number of
+  // cells at byte 8
+  if (function == 0x00) {
+    ESP_LOGV(TAG, "Unsolicited frame (%u bytes) ignored", length);
+    return;
+  }
+
   this->reset_online_status_tracker_();
 
-  // num_of_cells   frame_size   data_len
-  // 8              65           118 (0x76)   guessed
-  // 14             77           142 (0x8E)
-  // 15             79           146 (0x92)
-  // 16             81           150 (0x96)
-  if (data.size() >= 44 && data[8] >= 8 && data[8] <= 16) {
-    this->on_telemetry_data_(data);
+  //   3    0x00             Function code         CID2       0x00: Normal, 0x01 VER error, 0x02 Chksum error, ...
+  if (length >= 6 && data[3] != 0x00) {
+    ESP_LOGW(TAG, "Request 0x%02X rejected by the BMS (RTN: 0x%02X)", function, data[3]);
+    if (function == SEPLOS_CMD_PROTOCOL_VERSION)
+      this->protocol_version_received_ = true;
+    if (function == SEPLOS_CMD_MANUFACTURER_INFO)
+      this->manufacturer_info_received_ = true;
     return;
   }
 
+  switch (function) {
+    case SEPLOS_CMD_ALARMS:
+      this->on_alarm_data_(data, length);
+      return;
+    case SEPLOS_CMD_PROTOCOL_VERSION:
+      this->on_protocol_version_data_(data, length);
+      return;
+    case SEPLOS_CMD_MANUFACTURER_INFO:
+      this->on_manufacturer_info_data_(data, length);
+      return;
+    case SEPLOS_CMD_TELEMETRY:
+      // num_of_cells   frame_size   data_len
+      // 8              65           118 (0x76)   guessed
+      // 14             77           142 (0x8E)
+      // 15             79           146 (0x92)
+      // 16             81           150 (0x96)
+      if (length >= 44 && data[8] >= 8 && data[8] <= 16) {
+        if (!this->packs_.empty()) {
+          this->on_all_packs_telemetry_data_(data, length);
+          return;
+        }
+
+        ESP_LOGV(TAG, "Command group: %d", data[7]);
+        this->on_telemetry_data_(data, length);
+        return;
+      }
+      break;
+  }
+
   ESP_LOGW(TAG, "Unhandled data received (data_len: 0x%02X): %s", data[5],
-           format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
+           format_hex_pretty(data, length).c_str());  // NOLINT
 }
 
-void SeplosBms::on_telemetry_data_(const std::vector<uint8_t> &data) {
+void SeplosBms::on_telemetry_data_(const uint8_t *data, uint16_t length) {
   auto seplos_get_16bit = [&](size_t i) -> uint16_t {
     return (uint16_t(data[i + 0]) << 8) | (uint16_t(data[i + 1]) << 0);
   };
 
-  ESP_LOGI(TAG, "Telemetry frame (%zu bytes) received", data.size());
-  ESP_LOGVV(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
+  ESP_LOGI(TAG, "Telemetry frame (%u bytes) received", length);
+  ESP_LOGVV(TAG, "  %s", format_hex_pretty(data, length).c_str());  // NOLINT
 
   // ->
   // 0x2000460010960001100CD70CE90CF40CD60CEF0CE50CE10CDC0CE90CF00CE80CEF0CEA0CDA0CDE0CD8060BA60BA00B970BA60BA50BA2FD5C14A0344E0A426803134650004603E8149F0000000000000000
@@ -48,7 +240,6 @@ void SeplosBms::on_telemetry_data_(const std::vector<uint8_t> &data) {
   //   5    0x96             Data length           LENID      150 / 2 = 75
   //   6      0x00           Data flag
   //   7      0x01           Command group
-  ESP_LOGV(TAG, "Command group: %d", data[7]);
   //   8      0x10           Number of cells                  16
   uint8_t cells = (this->override_cell_count_) ? this->override_cell_count_ : data[8];
 
@@ -128,21 +319,21 @@ void SeplosBms::on_telemetry_data_(const std::vector<uint8_t> &data) {
   //   65     0x46 0x50      Rated capacity                   18000 * 0.01f = 180.00        Ah
   this->publish_state_(this->rated_capacity_sensor_, (float) seplos_get_16bit(offset + 11) * 0.01f);
 
-  if (data.size() < offset + 13 + 2) {
+  if (length < offset + 13 + 2) {
     return;
   }
 
   //   67     0x00 0x46      Number of cycles                 70
   this->publish_state_(this->charging_cycles_sensor_, (float) seplos_get_16bit(offset + 13));
 
-  if (data.size() < offset + 15 + 2) {
+  if (length < offset + 15 + 2) {
     return;
   }
 
   //   69     0x03 0xE8      State of health                  1000 * 0.1f = 100.0           %
   this->publish_state_(this->state_of_health_sensor_, (float) seplos_get_16bit(offset + 15) * 0.1f);
 
-  if (data.size() < offset + 17 + 2) {
+  if (length < offset + 17 + 2) {
     return;
   }
 
@@ -155,8 +346,284 @@ void SeplosBms::on_telemetry_data_(const std::vector<uint8_t> &data) {
   //   79     0x00 0x00      Reserved
 }
 
+void SeplosBms::on_all_packs_telemetry_data_(const uint8_t *data, uint16_t length) {
+  // Byte   Address Content: Description
+  //   0    0x20             Protocol version      VER
+  //   ...
+  //   6      0x00           Data flag
+  //   7      0x03           Number of packs
+  //   8      0x10 ...       Pack record 1 (same layout as byte 8 onwards of a single pack frame)
+  //   ...    ...            Pack record 2 ... n
+  uint8_t packs = data[7];
+  ESP_LOGI(TAG, "All-packs telemetry frame (%u bytes, %d packs) received", length, packs);
+
+  uint16_t offset = 8;
+  for (uint8_t i = 0; i < packs; i++) {
+    uint16_t record_length = telemetry_record_length(data, length, offset);
+    if (record_length == 0) {
+      ESP_LOGW(TAG, "All-packs telemetry frame truncated at pack record %d", i + 1);
+      return;
+    }
+
+    // The records are ordered by pack number starting with the pack of this device
+    uint8_t pack = this->pack_ + i;
+    SeplosBms *target = (pack == this->pack_) ? this : nullptr;
+    for (auto *candidate : this->packs_) {
+      if (candidate->pack_ == pack) {
+        target = candidate;
+        break;
+      }
+    }
+
+    if (target == nullptr) {
+      ESP_LOGD(TAG, "No sensors configured for pack %d", pack);
+    } else {
+      // The decoder expects the pack record at byte 8
+      target->reset_online_status_tracker_();
+      target->on_telemetry_data_(data + offset - 8, record_length + 8);
+    }
+
+    offset = offset + record_length;
+  }
+}
+
+void SeplosBms::on_alarm_data_(const uint8_t *data, uint16_t length) {
+  ESP_LOGI(TAG, "Alarm frame (%u bytes) received", length);
+  ESP_LOGVV(TAG, "  %s", format_hex_pretty(data, length).c_str());  // NOLINT
+
+  // ->
+  // 0x20004600A06000010F000000000000000000000000000000060000000000000000140000000000000300000200000000000000000002
+  //
+  // Byte   Address Content: Description                      Decoded content
+  //   0    0x20             Protocol version      VER        2.0
+  //   1    0x00             Device address        ADR
+  //   2    0x46             Device type           CID1       Lithium iron phosphate battery BMS
+  //   3    0x00             Function code         CID2       0x00: Normal, 0x01 VER error, 0x02 Chksum error, ...
+  //   4    0xA0             Data length checksum  LCHKSUM
+  //   5    0x60             Data length           LENID      96 / 2 = 48
+  //   6      0x00           Data flag
+  //   7      0x01           Command group
+  //   8      0x0F           Number of cells                  15
+  if (length < 10) {
+    ESP_LOGW(TAG, "Alarm frame too short (%u bytes)", length);
+    return;
+  }
+
+  uint8_t cells = data[8];
+  uint16_t offset = 9;
+
+  //   9      0x00           Cell 1 alarm                     0x00: normal, 0x01: below lower limit,
+  //   ...                                                    0x02: above upper limit, 0xF0: other error
+  //   23     0x00           Cell 15 alarm
+  if (length < offset + cells + 1) {
+    ESP_LOGW(TAG, "Alarm frame too short for %d cells (%u bytes)", cells, length);
+    return;
+  }
+
+  uint16_t cell_voltage_alarm_bitmask = 0;
+  for (uint8_t i = 0; i < cells && i < 16; i++) {
+    if (data[offset + i] != 0x00) {
+      cell_voltage_alarm_bitmask |= 1 << i;
+    }
+  }
+  this->publish_state_(this->cell_voltage_alarm_bitmask_sensor_, (float) cell_voltage_alarm_bitmask);
+  offset = offset + cells;
+
+  //   24     0x06           Number of temperatures           6
+  //   25     0x00           Temperature 1 alarm
+  //   ...
+  //   30     0x00           Temperature 6 alarm
+  uint8_t temperatures = data[offset];
+  offset++;
+  if (length < offset + temperatures + 3) {
+    ESP_LOGW(TAG, "Alarm frame too short for %d temperatures (%u bytes)", temperatures, length);
+    return;
+  }
+
+  uint8_t temperature_alarm_bitmask = 0;
+  for (uint8_t i = 0; i < temperatures && i < 8; i++) {
+    if (data[offset + i] != 0x00) {
+      temperature_alarm_bitmask |= 1 << i;
+    }
+  }
+  this->publish_state_(this->temperature_alarm_bitmask_sensor_, (float) temperature_alarm_bitmask);
+  offset = offset + temperatures;
+
+  //   31     0x00           Charge/discharge current alarm
+  //   32     0x00           Total battery voltage alarm
+  //   33     0x14           Custom number                    20
+  uint8_t custom = data[offset + 2];
+  const uint16_t states_end = offset + 2;
+  offset = offset + 3;
+
+  //   34     0x00           Alarm event 1
+  //   35     0x00           Alarm event 2
+  //   36     0x00           Alarm event 3
+  //   37     0x00           Alarm event 4
+  //   38     0x00           Alarm event 5
+  //   39     0x00           Alarm event 6
+  //   40     0x03           On-off state                     Bit 0: Discharge, Bit 1: Charge, Bit 2: Current limit,
+  //                                                          Bit 3: Heating
+  //   41     0x00 0x00      Equilibrium state (cells 1-16)
+  //   43     0x02           System state                     Bit 0: Discharge, Bit 1: Charge, Bit 2: Floating charge,
+  //                                                          Bit 4: Standby, Bit 5: Shutdown
+  //   44     0x00 0x00      Disconnection state (cells 1-16)
+  //   46     0x00           Alarm event 7
+  //   47     0x00           Alarm event 8
+  //   48     0x00 ...       Reserved
+  if (custom < 6 || length < offset + 6) {
+    ESP_LOGW(TAG, "Alarm frame without alarm events (custom number: %d)", custom);
+    this->publish_errors_(data + 8, states_end - 8, nullptr);
+    return;
+  }
+
+  uint8_t alarm_events[8] = {data[offset + 0], data[offset + 1], data[offset + 2], data[offset + 3],
+                             data[offset + 4], data[offset + 5], 0x00, 0x00};
+  if (custom >= 14 && length >= offset + 14) {
+    alarm_events[6] = data[offset + 12];
+    alarm_events[7] = data[offset + 13];
+  }
+
+  ESP_LOGV(TAG, "On-off state: 0x%02X", custom >= 7 ? data[offset + 6] : 0x00);
+
+  this->publish_state_(this->alarm_event1_bitmask_sensor_, (float) alarm_events[0]);
+  this->publish_state_(this->alarm_event2_bitmask_sensor_, (float) alarm_events[1]);
+  this->publish_state_(this->alarm_event3_bitmask_sensor_, (float) alarm_events[2]);
+  this->publish_state_(this->alarm_event4_bitmask_sensor_, (float) alarm_events[3]);
+  this->publish_state_(this->alarm_event5_bitmask_sensor_, (float) alarm_events[4]);
+  this->publish_state_(this->alarm_event6_bitmask_sensor_, (float) alarm_events[5]);
+  this->publish_state_(this->alarm_event7_bitmask_sensor_, (float) alarm_events[6]);
+  this->publish_state_(this->alarm_event8_bitmask_sensor_, (float) alarm_events[7]);
+
+  // Single/total over- and undervoltage protection
+  this->publish_state_(this->voltage_protection_binary_sensor_, (alarm_events[1] & 0xAA) != 0);
+  // Charging/discharge over- and undertemperature, ambient over- and undertemperature and power overtemperature
+  this->publish_state_(this->temperature_protection_binary_sensor_,
+                       (alarm_events[2] & 0xAA) != 0 || (alarm_events[3] & 0x1A) != 0);
+  // Charging/discharge overcurrent, transient overcurrent and short circuit protection
+  this->publish_state_(this->current_protection_binary_sensor_, (alarm_events[4] & 0xFA) != 0);
+
+  this->publish_errors_(data + 8, states_end - 8, alarm_events);
+}
+
+void SeplosBms::publish_errors_(const uint8_t *states, uint16_t length, const uint8_t *alarm_events) {
+  if (this->errors_text_sensor_ == nullptr)
+    return;
+
+  // The text is rebuilt only if one of the alarm states changed. states starts with the number of cells:
+  // cell states, number of temperatures, temperature states, current and total voltage state
+  uint8_t key[ALARM_STATES_SIZE];
+  const uint16_t key_length = length + 1 + 8;
+  if (key_length <= ALARM_STATES_SIZE) {
+    std::memcpy(key, states, length);
+    key[length] = alarm_events != nullptr;
+    for (uint8_t event = 0; event < 8; event++)
+      key[length + 1 + event] = alarm_events != nullptr ? alarm_events[event] : 0x00;
+
+    if (key_length == this->alarm_states_length_ && std::memcmp(key, this->alarm_states_, key_length) == 0)
+      return;
+    std::memcpy(this->alarm_states_, key, key_length);
+    this->alarm_states_length_ = key_length;
+  } else {
+    this->alarm_states_length_ = 0;
+  }
+
+  std::string alarms;
+  const uint8_t cells = states[0];
+  for (uint8_t i = 0; i < cells; i++) {
+    uint8_t state = states[1 + i];
+    if (state != 0x00) {
+      append_alarm(alarms, str_sprintf("Cell %d voltage %s", i + 1, alarm_state_to_string(state)));
+    }
+  }
+
+  const uint8_t temperatures = states[1 + cells];
+  for (uint8_t i = 0; i < temperatures; i++) {
+    uint8_t state = states[2 + cells + i];
+    if (state != 0x00) {
+      append_alarm(alarms, str_sprintf("Temperature %d %s", i + 1, alarm_state_to_string(state)));
+    }
+  }
+
+  const uint16_t current = 2 + cells + temperatures;
+  if (states[current] != 0x00) {
+    append_alarm(alarms, str_sprintf("Current %s", alarm_state_to_string(states[current])));
+  }
+  if (states[current + 1] != 0x00) {
+    append_alarm(alarms, str_sprintf("Total voltage %s", alarm_state_to_string(states[current + 1])));
+  }
+
+  if (alarm_events != nullptr) {
+    const char *const *alarm_messages[8] = {ALARM_EVENT1_MESSAGES, ALARM_EVENT2_MESSAGES, ALARM_EVENT3_MESSAGES,
+                                            ALARM_EVENT4_MESSAGES, ALARM_EVENT5_MESSAGES, ALARM_EVENT6_MESSAGES,
+                                            ALARM_EVENT7_MESSAGES, ALARM_EVENT8_MESSAGES};
+    for (uint8_t event = 0; event < 8; event++) {
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        if (alarm_events[event] & (1 << bit)) {
+          append_alarm(alarms, alarm_messages[event][bit]);
+        }
+      }
+    }
+  }
+
+  this->publish_state_(this->errors_text_sensor_, alarms.empty() ? "No alarms" : alarms);
+}
+
+void SeplosBms::on_protocol_version_data_(const uint8_t *data, uint16_t length) {
+  ESP_LOGI(TAG, "Protocol version frame (%u bytes) received", length);
+
+  // ->
+  // 0x200046000000
+  //
+  // Byte   Address Content: Description                      Decoded content
+  //   0    0x20             Protocol version      VER        2.0
+  //   1    0x00             Device address        ADR
+  //   2    0x46             Device type           CID1       Lithium iron phosphate battery BMS
+  //   3    0x00             Function code         CID2       0x00: Normal
+  //   4    0x00             Data length checksum  LCHKSUM
+  //   5    0x00             Data length           LENID      0
+  this->publish_state_(this->protocol_version_text_sensor_, str_sprintf("%d.%d", data[0] >> 4, data[0] & 0x0F));
+  this->protocol_version_received_ = true;
+}
+
+void SeplosBms::on_manufacturer_info_data_(const uint8_t *data, uint16_t length) {
+  ESP_LOGI(TAG, "Manufacturer info frame (%u bytes) received", length);
+  ESP_LOGVV(TAG, "  %s", format_hex_pretty(data, length).c_str());  // NOLINT
+
+  // ->
+  // 0x20004600C040313130312D5A4832362002062020202020202020202020202020202020202020
+  //
+  // Byte   Address Content: Description                      Decoded content
+  //   0    0x20             Protocol version      VER        2.0
+  //   1    0x00             Device address        ADR
+  //   2    0x46             Device type           CID1       Lithium iron phosphate battery BMS
+  //   3    0x00             Function code         CID2       0x00: Normal
+  //   4    0xC0             Data length checksum  LCHKSUM
+  //   5    0x40             Data length           LENID      64 / 2 = 32
+  if (length < 6 + 32) {
+    ESP_LOGW(TAG, "Manufacturer info frame too short (%u bytes)", length);
+    return;
+  }
+
+  //   6    0x31 ... 0x20    Device name (10 chars)           1101-ZH26
+  this->publish_state_(this->device_model_text_sensor_, trimmed_string(data + 6, 10));
+
+  //   16   0x02 0x06        Software version                 2.6
+  this->publish_state_(this->software_version_text_sensor_, str_sprintf("%u.%u", data[16], data[17]));
+
+  //   18   0x20 ... 0x20    Manufacturer name (20 chars)
+  this->publish_state_(this->manufacturer_text_sensor_, trimmed_string(data + 18, 20));
+
+  this->manufacturer_info_received_ = true;
+}
+
 void SeplosBms::dump_config() {
   ESP_LOGCONFIG(TAG, "SeplosBms:");
+  ESP_LOGCONFIG(TAG, "  Alarm update interval: %" PRIu32 " ms", this->alarm_update_interval_);
+  ESP_LOGCONFIG(TAG, "  Pack: %d", this->pack_);
+  if (!this->packs_.empty()) {
+    ESP_LOGCONFIG(TAG, "  All-packs request for %u additional packs", (unsigned) this->packs_.size());
+  }
   LOG_SENSOR("", "Minimum Cell Voltage", this->min_cell_voltage_sensor_);
   LOG_SENSOR("", "Maximum Cell Voltage", this->max_cell_voltage_sensor_);
   LOG_SENSOR("", "Minimum Voltage Cell", this->min_voltage_cell_sensor_);
@@ -197,6 +664,24 @@ void SeplosBms::dump_config() {
   LOG_SENSOR("", "Average Cell Voltage", this->average_cell_voltage_sensor_);
   LOG_SENSOR("", "State of health", this->state_of_health_sensor_);
   LOG_SENSOR("", "Port Voltage", this->port_voltage_sensor_);
+  LOG_SENSOR("", "Cell Voltage Alarm Bitmask", this->cell_voltage_alarm_bitmask_sensor_);
+  LOG_SENSOR("", "Temperature Alarm Bitmask", this->temperature_alarm_bitmask_sensor_);
+  LOG_SENSOR("", "Alarm Event 1 Bitmask", this->alarm_event1_bitmask_sensor_);
+  LOG_SENSOR("", "Alarm Event 2 Bitmask", this->alarm_event2_bitmask_sensor_);
+  LOG_SENSOR("", "Alarm Event 3 Bitmask", this->alarm_event3_bitmask_sensor_);
+  LOG_SENSOR("", "Alarm Event 4 Bitmask", this->alarm_event4_bitmask_sensor_);
+  LOG_SENSOR("", "Alarm Event 5 Bitmask", this->alarm_event5_bitmask_sensor_);
+  LOG_SENSOR("", "Alarm Event 6 Bitmask", this->alarm_event6_bitmask_sensor_);
+  LOG_SENSOR("", "Alarm Event 7 Bitmask", this->alarm_event7_bitmask_sensor_);
+  LOG_SENSOR("", "Alarm Event 8 Bitmask", this->alarm_event8_bitmask_sensor_);
+  LOG_BINARY_SENSOR("", "Voltage Protection", this->voltage_protection_binary_sensor_);
+  LOG_BINARY_SENSOR("", "Temperature Protection", this->temperature_protection_binary_sensor_);
+  LOG_BINARY_SENSOR("", "Current Protection", this->current_protection_binary_sensor_);
+  LOG_TEXT_SENSOR("", "Errors", this->errors_text_sensor_);
+  LOG_TEXT_SENSOR("", "Protocol Version", this->protocol_version_text_sensor_);
+  LOG_TEXT_SENSOR("", "Device Model", this->device_model_text_sensor_);
+  LOG_TEXT_SENSOR("", "Software Version", this->software_version_text_sensor_);
+  LOG_TEXT_SENSOR("", "Manufacturer", this->manufacturer_text_sensor_);
 }
 
 float SeplosBms::get_setup_priority() const {
@@ -206,7 +691,19 @@ float SeplosBms::get_setup_priority() const {
 
 void SeplosBms::update() {
   this->track_online_status_();
-  this->send(0x42, this->pack_);
+
+  // The telemetry of this pack is requested by the all-packs source
+  if (this->all_packs_source_ == nullptr) {
+    this->send(SEPLOS_CMD_TELEMETRY, this->packs_.empty() ? this->pack_ : SEPLOS_ALL_PACKS);
+  }
+
+  if (!this->protocol_version_received_) {
+    this->send(SEPLOS_CMD_PROTOCOL_VERSION);
+  }
+
+  if (!this->manufacturer_info_received_) {
+    this->send(SEPLOS_CMD_MANUFACTURER_INFO);
+  }
 }
 
 void SeplosBms::publish_state_(binary_sensor::BinarySensor *binary_sensor, const bool &state) {
@@ -267,6 +764,16 @@ void SeplosBms::publish_device_unavailable_() {
   this->publish_state_(this->charging_cycles_sensor_, NAN);
   this->publish_state_(this->state_of_health_sensor_, NAN);
   this->publish_state_(this->port_voltage_sensor_, NAN);
+  this->publish_state_(this->cell_voltage_alarm_bitmask_sensor_, NAN);
+  this->publish_state_(this->temperature_alarm_bitmask_sensor_, NAN);
+  this->publish_state_(this->alarm_event1_bitmask_sensor_, NAN);
+  this->publish_state_(this->alarm_event2_bitmask_sensor_, NAN);
+  this->publish_state_(this->alarm_event3_bitmask_sensor_, NAN);
+  this->publish_state_(this->alarm_event4_bitmask_sensor_, NAN);
+  this->publish_state_(this->alarm_event5_bitmask_sensor_, NAN);
+  this->publish_state_(this->alarm_event6_bitmask_sensor_, NAN);
+  this->publish_state_(this->alarm_event7_bitmask_sensor_, NAN);
+  this->publish_state_(this->alarm_event8_bitmask_sensor_, NAN);
 
   for (auto &temperature : this->temperatures_) {
     this->publish_state_(temperature.temperature_sensor_, NAN);
@@ -6,13 +6,28 @@
 #include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/components/seplos_modbus/seplos_modbus.h"
 
+#include <vector>
+
 namespace esphome::seplos_bms {
 
+// Number of cells, cell states, number of temperatures, temperature states, current and total voltage state,
+// alarm events flag and alarm events
+static const uint8_t ALARM_STATES_SIZE = 1 + 16 + 1 + 8 + 2 + 1 + 8;
+
 class SeplosBms : public PollingComponent, public seplos_modbus::SeplosModbusDevice {
  public:
   void set_online_status_binary_sensor(binary_sensor::BinarySensor *online_status_binary_sensor) {
     online_status_binary_sensor_ = online_status_binary_sensor;
   }
+  void set_voltage_protection_binary_sensor(binary_sensor::BinarySensor *voltage_protection_binary_sensor) {
+    voltage_protection_binary_sensor_ = voltage_protection_binary_sensor;
+  }
+  void set_temperature_protection_binary_sensor(binary_sensor::BinarySensor *temperature_protection_binary_sensor) {
+    temperature_protection_binary_sensor_ = temperature_protection_binary_sensor;
+  }
+  void set_current_protection_binary_sensor(binary_sensor::BinarySensor *current_protection_binary_sensor) {
+    current_protection_binary_sensor_ = current_protection_binary_sensor;
+  }
 
   void set_min_cell_voltage_sensor(sensor::Sensor *min_cell_voltage_sensor) {
     min_cell_voltage_sensor_ = min_cell_voltage_sensor;
@@ -66,19 +81,72 @@ class SeplosBms : public PollingComponent, public seplos_modbus::SeplosModbusDev
     state_of_health_sensor_ = state_of_health_sensor;
   }
   void set_port_voltage_sensor(sensor::Sensor *port_voltage_sensor) { port_voltage_sensor_ = port_voltage_sensor; }
+  void set_cell_voltage_alarm_bitmask_sensor(sensor::Sensor *cell_voltage_alarm_bitmask_sensor) {
+    cell_voltage_alarm_bitmask_sensor_ = cell_voltage_alarm_bitmask_sensor;
+  }
+  void set_temperature_alarm_bitmask_sensor(sensor::Sensor *temperature_alarm_bitmask_sensor) {
+    temperature_alarm_bitmask_sensor_ = temperature_alarm_bitmask_sensor;
+  }
+  void set_alarm_event1_bitmask_sensor(sensor::Sensor *alarm_event1_bitmask_sensor) {
+    alarm_event1_bitmask_sensor_ = alarm_event1_bitmask_sensor;
+  }
+  void set_alarm_event2_bitmask_sensor(sensor::Sensor *alarm_event2_bitmask_sensor) {
+    alarm_event2_bitmask_sensor_ = alarm_event2_bitmask_sensor;
+  }
+  void set_alarm_event3_bitmask_sensor(sensor::Sensor *alarm_event3_bitmask_sensor) {
+    alarm_event3_bitmask_sensor_ = alarm_event3_bitmask_sensor;
+  }
+  void set_alarm_event4_bitmask_sensor(sensor::Sensor *alarm_event4_bitmask_sensor) {
+    alarm_event4_bitmask_sensor_ = alarm_event4_bitmask_sensor;
+  }
+  void set_alarm_event5_bitmask_sensor(sensor::Sensor *alarm_event5_bitmask_sensor) {
+    alarm_event5_bitmask_sensor_ = alarm_event5_bitmask_sensor;
+  }
+  void set_alarm_event6_bitmask_sensor(sensor::Sensor *alarm_event6_bitmask_sensor) {
+    alarm_event6_bitmask_sensor_ = alarm_event6_bitmask_sensor;
+  }
+  void set_alarm_event7_bitmask_sensor(sensor::Sensor *alarm_event7_bitmask_sensor) {
+    alarm_event7_bitmask_sensor_ = alarm_event7_bitmask_sensor;
+  }
+  void set_alarm_event8_bitmask_sensor(sensor::Sensor *alarm_event8_bitmask_sensor) {
+    alarm_event8_bitmask_sensor_ = alarm_event8_bitmask_sensor;
+  }
 
   void set_errors_text_sensor(text_sensor::TextSensor *errors_text_sensor) { errors_text_sensor_ = errors_text_sensor; }
+  void set_protocol_version_text_sensor(text_sensor::TextSensor *protocol_version_text_sensor) {
+    protocol_version_text_sensor_ = protocol_version_text_sensor;
+  }
+  void set_device_model_text_sensor(text_sensor::TextSensor *device_model_text_sensor) {
+    device_model_text_sensor_ = device_model_text_sensor;
+  }
+  void set_software_version_text_sensor(text_sensor::TextSensor *software_version_text_sensor) {
+    software_version_text_sensor_ = software_version_text_sensor;
+  }
+  void set_manufacturer_text_sensor(text_sensor::TextSensor *manufacturer_text_sensor) {
+    manufacturer_text_sensor_ = manufacturer_text_sensor;
+  }
 
   void set_override_cell_count(uint8_t override_cell_count) { this->override_cell_count_ = override_cell_count; }
+  void set_all_packs_source(SeplosBms *all_packs_source) {
+    this->all_packs_source_ = all_packs_source;
+    all_packs_source->packs_.push_back(this);
+  }
+  void set_alarm_update_interval(uint32_t alarm_update_interval) {
+    this->alarm_update_interval_ = alarm_update_interval;
+  }
 
-  void on_seplos_modbus_data(const std::vector<uint8_t> &data) override;
+  void on_seplos_modbus_data(uint8_t function, const uint8_t *data, uint16_t length) override;
 
+  void setup() override;
   void dump_config() override;
   void update() override;
   float get_setup_priority() const override;
 
  protected:
   binary_sensor::BinarySensor *online_status_binary_sensor_{nullptr};
+  binary_sensor::BinarySensor *voltage_protection_binary_sensor_{nullptr};
+  binary_sensor::BinarySensor *temperature_protection_binary_sensor_{nullptr};
+  binary_sensor::BinarySensor *current_protection_binary_sensor_{nullptr};
 
   sensor::Sensor *min_cell_voltage_sensor_{nullptr};
   sensor::Sensor *max_cell_voltage_sensor_{nullptr};
@@ -98,8 +166,22 @@ class SeplosBms : public PollingComponent, public seplos_modbus::SeplosModbusDev
   sensor::Sensor *charging_cycles_sensor_{nullptr};
   sensor::Sensor *state_of_health_sensor_{nullptr};
   sensor::Sensor *port_voltage_sensor_{nullptr};
+  sensor::Sensor *cell_voltage_alarm_bitmask_sensor_{nullptr};
+  sensor::Sensor *temperature_alarm_bitmask_sensor_{nullptr};
+  sensor::Sensor *alarm_event1_bitmask_sensor_{nullptr};
+  sensor::Sensor *alarm_event2_bitmask_sensor_{nullptr};
+  sensor::Sensor *alarm_event3_bitmask_sensor_{nullptr};
+  sensor::Sensor *alarm_event4_bitmask_sensor_{nullptr};
+  sensor::Sensor *alarm_event5_bitmask_sensor_{nullptr};
+  sensor::Sensor *alarm_event6_bitmask_sensor_{nullptr};
+  sensor::Sensor *alarm_event7_bitmask_sensor_{nullptr};
+  sensor::Sensor *alarm_event8_bitmask_sensor_{nullptr};
 
   text_sensor::TextSensor *errors_text_sensor_{nullptr};
+  text_sensor::TextSensor *protocol_version_text_sensor_{nullptr};
+  text_sensor::TextSensor *device_model_text_sensor_{nullptr};
+  text_sensor::TextSensor *software_version_text_sensor_{nullptr};
+  text_sensor::TextSensor *manufacturer_text_sensor_{nullptr};
 
   struct Cell {
     sensor::Sensor *cell_voltage_sensor_{nullptr};
@@ -110,12 +192,27 @@ class SeplosBms : public PollingComponent, public seplos_modbus::SeplosModbusDev
   } temperatures_[6];
 
   uint8_t override_cell_count_{0};
+  // Packs fed by the all-packs telemetry request of this device (or the device feeding this pack)
+  std::vector<SeplosBms *> packs_;
+  SeplosBms *all_packs_source_{nullptr};
+  uint32_t alarm_update_interval_{1000};
+  // Static information is requested once per boot (retried on every update until answered)
+  bool protocol_version_received_{false};
+  bool manufacturer_info_received_{false};
   uint8_t no_response_count_{0};
+  // Alarm states the errors text was built from (cells and temperatures up to 16 and 8)
+  uint8_t alarm_states_[ALARM_STATES_SIZE]{};
+  uint8_t alarm_states_length_{0};
 
   void publish_state_(binary_sensor::BinarySensor *binary_sensor, const bool &state);
   void publish_state_(sensor::Sensor *sensor, float value);
   void publish_state_(text_sensor::TextSensor *text_sensor, const std::string &state);
-  void on_telemetry_data_(const std::vector<uint8_t> &data);
+  void on_telemetry_data_(const uint8_t *data, uint16_t length);
+  void on_all_packs_telemetry_data_(const uint8_t *data, uint16_t length);
+  void on_alarm_data_(const uint8_t *data, uint16_t length);
+  void publish_errors_(const uint8_t *states, uint16_t length, const uint8_t *alarm_events);
+  void on_protocol_version_data_(const uint8_t *data, uint16_t length);
+  void on_manufacturer_info_data_(const uint8_t *data, uint16_t length);
   void reset_online_status_tracker_();
   void track_online_status_();
   void publish_device_unavailable_();
@@ -10,11 +10,23 @@ DEPENDENCIES = ["seplos_bms"]
 CODEOWNERS = ["@syssi"]
 
 CONF_ERRORS = "errors"
+CONF_PROTOCOL_VERSION = "protocol_version"
+CONF_DEVICE_MODEL = "device_model"
+CONF_SOFTWARE_VERSION = "software_version"
+CONF_MANUFACTURER = "manufacturer"
 
 ICON_ERRORS = "mdi:alert-circle-outline"
+ICON_PROTOCOL_VERSION = "mdi:numeric"
+ICON_DEVICE_MODEL = "mdi:chip"
+ICON_SOFTWARE_VERSION = "mdi:numeric"
+ICON_MANUFACTURER = "mdi:factory"
 
 TEXT_SENSORS = [
     CONF_ERRORS,
+    CONF_PROTOCOL_VERSION,
+    CONF_DEVICE_MODEL,
+    CONF_SOFTWARE_VERSION,
+    CONF_MANUFACTURER,
 ]
 
 CONFIG_SCHEMA = SEPLOS_BMS_COMPONENT_SCHEMA.extend(
@@ -23,6 +35,22 @@ CONFIG_SCHEMA = SEPLOS_BMS_COMPONENT_SCHEMA.extend(
             icon=ICON_ERRORS,
             entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
         ),
+        cv.Optional(CONF_PROTOCOL_VERSION): text_sensor.text_sensor_schema(
+            icon=ICON_PROTOCOL_VERSION,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_DEVICE_MODEL): text_sensor.text_sensor_schema(
+            icon=ICON_DEVICE_MODEL,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_SOFTWARE_VERSION): text_sensor.text_sensor_schema(
+            icon=ICON_SOFTWARE_VERSION,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_MANUFACTURER): text_sensor.text_sensor_schema(
+            icon=ICON_MANUFACTURER,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
     }
 )
 
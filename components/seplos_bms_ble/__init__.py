@@ -1,20 +1,35 @@
+from esphome import automation
 import esphome.codegen as cg
 from esphome.components import ble_client
 import esphome.config_validation as cv
-from esphome.const import CONF_ID
+from esphome.const import CONF_ID, CONF_TRIGGER_ID
 
 CODEOWNERS = ["@syssi"]
 DEPENDENCIES = ["ble_client"]
-AUTO_LOAD = ["binary_sensor", "sensor", "switch", "text_sensor"]
+AUTO_LOAD = ["seplos_ble", "seplos_checksum", "binary_sensor", "sensor", "switch", "text_sensor"]
 
 MULTI_CONF = True
 
 CONF_SEPLOS_BMS_BLE_ID = "seplos_bms_ble_id"
+CONF_RESPONSE_TIMEOUT = "response_timeout"
+CONF_MAX_RETRIES = "max_retries"
+CONF_MTU = "mtu"
+CONF_ON_ALARM_SET = "on_alarm_set"
+CONF_ON_ALARM_CLEARED = "on_alarm_cleared"
 
 seplos_bms_ble_ns = cg.esphome_ns.namespace("seplos_bms_ble")
 SeplosBmsBle = seplos_bms_ble_ns.class_(
     "SeplosBmsBle", ble_client.BLEClientNode, cg.PollingComponent
 )
+AlarmSetTrigger = seplos_bms_ble_ns.class_(
+    "AlarmSetTrigger", automation.Trigger.template(cg.uint8, cg.const_char_ptr)
+)
+AlarmClearedTrigger = seplos_bms_ble_ns.class_(
+    "AlarmClearedTrigger", automation.Trigger.template(cg.uint8, cg.const_char_ptr)
+)
+
+# Arguments of the alarm automations: alarm (event * 8 + bit) and message
+ALARM_TRIGGER_ARGS = [(cg.uint8, "alarm"), (cg.const_char_ptr, "message")]
 
 SEPLOS_BMS_BLE_COMPONENT_SCHEMA = cv.Schema(
     {
@@ -27,6 +42,17 @@ CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(SeplosBmsBle),
+            cv.Optional(
+                CONF_RESPONSE_TIMEOUT, default="500ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_MAX_RETRIES, default=1): cv.int_range(min=0, max=10),
+            cv.Optional(CONF_MTU, default=247): cv.int_range(min=23, max=517),
+            cv.Optional(CONF_ON_ALARM_SET): automation.validate_automation(
+                {cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(AlarmSetTrigger)}
+            ),
+            cv.Optional(CONF_ON_ALARM_CLEARED): automation.validate_automation(
+                {cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(AlarmClearedTrigger)}
+            ),
         }
     )
     .extend(ble_client.BLE_CLIENT_SCHEMA)
@@ -38,3 +64,14 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await ble_client.register_ble_node(var, config)
+
+    cg.add(var.set_response_timeout(config[CONF_RESPONSE_TIMEOUT]))
+    cg.add(var.set_max_retries(config[CONF_MAX_RETRIES]))
+    cg.add(var.set_mtu(config[CONF_MTU]))
+
+    for conf in config.get(CONF_ON_ALARM_SET, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, ALARM_TRIGGER_ARGS, conf)
+    for conf in config.get(CONF_ON_ALARM_CLEARED, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, ALARM_TRIGGER_ARGS, conf)
@@ -16,6 +16,8 @@ from esphome.const import (
     UNIT_AMPERE,
     UNIT_CELSIUS,
     UNIT_EMPTY,
+    UNIT_HOUR,
+    UNIT_MILLISECOND,
     UNIT_PERCENT,
     UNIT_VOLT,
     UNIT_WATT,
@@ -92,6 +94,97 @@ UNIT_AMPERE_HOURS = "Ah"
 CELLS = [f"cell_voltage_{i}" for i in range(1, 25)]
 TEMPERATURES = [f"temperature_{i}" for i in range(1, 9)]
 
+# Protection thresholds and parameters of the settings frame in frame order (SeplosSettings::values)
+CELL_VOLTAGE_SETTINGS = [
+    "cell_high_voltage_alarm",
+    "cell_high_voltage_alarm_recovery",
+    "cell_low_voltage_alarm",
+    "cell_low_voltage_alarm_recovery",
+    "cell_overvoltage_protection",
+    "cell_overvoltage_recovery",
+    "cell_undervoltage_protection",
+    "cell_undervoltage_recovery",
+    "balancer_trigger_voltage",
+    "cell_low_voltage_charging_prohibited",
+]
+TOTAL_VOLTAGE_SETTINGS = [
+    "total_high_voltage_alarm",
+    "total_high_voltage_alarm_recovery",
+    "total_low_voltage_alarm",
+    "total_low_voltage_alarm_recovery",
+    "total_overvoltage_protection",
+    "total_overvoltage_recovery",
+    "total_undervoltage_protection",
+    "total_undervoltage_recovery",
+    "charging_overvoltage_protection",
+    "charging_overvoltage_recovery",
+]
+TEMPERATURE_SETTINGS = [
+    f"{prefix}_{threshold}"
+    for prefix in ("charging", "discharging")
+    for threshold in (
+        "high_temperature_alarm",
+        "high_temperature_alarm_recovery",
+        "low_temperature_alarm",
+        "low_temperature_alarm_recovery",
+        "overtemperature_protection",
+        "overtemperature_recovery",
+        "undertemperature_protection",
+        "undertemperature_recovery",
+    )
+] + [
+    "cell_heating_temperature",
+    "cell_heating_recovery",
+    "ambient_high_temperature_alarm",
+    "ambient_high_temperature_alarm_recovery",
+    "ambient_low_temperature_alarm",
+    "ambient_low_temperature_alarm_recovery",
+    "ambient_overtemperature_protection",
+    "ambient_overtemperature_recovery",
+    "ambient_undertemperature_protection",
+    "ambient_undertemperature_recovery",
+    "mosfet_high_temperature_alarm",
+    "mosfet_high_temperature_alarm_recovery",
+    "mosfet_overtemperature_protection",
+    "mosfet_overtemperature_recovery",
+]
+CURRENT_SETTINGS = [
+    "charging_overcurrent_alarm",
+    "charging_overcurrent_alarm_recovery",
+    "discharging_overcurrent_alarm",
+    "discharging_overcurrent_alarm_recovery",
+    "charging_overcurrent_protection",
+    "discharging_overcurrent_protection",
+    "transient_overcurrent_protection",
+]
+
+
+def _setting_schema(unit, accuracy_decimals, device_class=DEVICE_CLASS_EMPTY):
+    return sensor.sensor_schema(
+        unit_of_measurement=unit,
+        icon=ICON_EMPTY,
+        accuracy_decimals=accuracy_decimals,
+        device_class=device_class,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+SETTINGS = {
+    **{key: _setting_schema(UNIT_VOLT, 3, DEVICE_CLASS_VOLTAGE) for key in CELL_VOLTAGE_SETTINGS},
+    **{key: _setting_schema(UNIT_VOLT, 2, DEVICE_CLASS_VOLTAGE) for key in TOTAL_VOLTAGE_SETTINGS},
+    **{key: _setting_schema(UNIT_CELSIUS, 1, DEVICE_CLASS_TEMPERATURE) for key in TEMPERATURE_SETTINGS},
+    **{key: _setting_schema(UNIT_AMPERE, 2, DEVICE_CLASS_CURRENT) for key in CURRENT_SETTINGS},
+    "soft_start_delay": _setting_schema(UNIT_MILLISECOND, 0),
+    "rated_capacity": _setting_schema(UNIT_AMPERE_HOURS, 2),
+    "remaining_capacity_setting": _setting_schema(UNIT_AMPERE_HOURS, 2),
+    "cell_failure_voltage_difference": _setting_schema(UNIT_VOLT, 2, DEVICE_CLASS_VOLTAGE),
+    "cell_failure_voltage_difference_recovery": _setting_schema(UNIT_VOLT, 2, DEVICE_CLASS_VOLTAGE),
+    "balancer_start_voltage_difference": _setting_schema(UNIT_VOLT, 3, DEVICE_CLASS_VOLTAGE),
+    "balancer_stop_voltage_difference": _setting_schema(UNIT_VOLT, 3, DEVICE_CLASS_VOLTAGE),
+    "static_balancing_time": _setting_schema(UNIT_HOUR, 0),
+    "cells_in_series": _setting_schema(UNIT_EMPTY, 0),
+}
+
 # key: sensor_schema kwargs
 SENSOR_DEFS = {
     CONF_TOTAL_VOLTAGE: {
@@ -344,6 +437,7 @@ CONFIG_SCHEMA = (
     )
     .extend({cv.Optional(key): _CELL_VOLTAGE_SCHEMA for key in CELLS})
     .extend({cv.Optional(key): _TEMPERATURE_SCHEMA for key in TEMPERATURES})
+    .extend({cv.Optional(key): schema for key, schema in SETTINGS.items()})
 )
 
 
@@ -359,6 +453,11 @@ async def to_code(config):
             conf = config[key]
             sens = await sensor.new_sensor(conf)
             cg.add(hub.set_cell_voltage_sensor(i, sens))
+    for i, key in enumerate(SETTINGS):
+        if key in config:
+            conf = config[key]
+            sens = await sensor.new_sensor(conf)
+            cg.add(hub.set_setting_sensor(i, sens))
     for key in SENSOR_DEFS:
         if key in config:
             conf = config[key]
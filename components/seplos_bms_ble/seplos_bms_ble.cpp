@@ -1,7 +1,14 @@
 #include "seplos_bms_ble.h"
 #include "esphome/core/log.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/version.h"
+#include "esphome/components/seplos_checksum/seplos_checksum.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <string>
 
 #if ESPHOME_VERSION_CODE >= VERSION_CODE(2025, 12, 0)
 #define ADDR_STR(x) x
@@ -11,21 +18,6 @@
 
 namespace esphome::seplos_bms_ble {
 
-static uint16_t crc_xmodem(const uint8_t *data, uint16_t len) {
-  uint16_t crc = 0x0000;
-  for (uint16_t i = 0; i < len; i++) {
-    crc ^= (uint16_t) data[i] << 8;
-    for (uint8_t j = 0; j < 8; j++) {
-      if (crc & 0x8000) {
-        crc = (crc << 1) ^ 0x1021;
-      } else {
-        crc <<= 1;
-      }
-    }
-  }
-  return crc;
-}
-
 static const char *const TAG = "seplos_bms_ble";
 
 static constexpr const char *const ALARM_EVENT1_MESSAGES[8] = {
@@ -116,12 +108,26 @@ static constexpr const char *const ALARM_EVENT8_MESSAGES[8] = {
     "Internal system error 7"           // Bit 7
 };
 
+static constexpr const char *const *const ALARM_EVENT_MESSAGES[SEPLOS_ALARM_EVENT_COUNT] = {
+    ALARM_EVENT1_MESSAGES, ALARM_EVENT2_MESSAGES, ALARM_EVENT3_MESSAGES, ALARM_EVENT4_MESSAGES,
+    ALARM_EVENT5_MESSAGES, ALARM_EVENT6_MESSAGES, ALARM_EVENT7_MESSAGES, ALARM_EVENT8_MESSAGES};
+
+// Every message plus a separator or the terminating null byte
+static constexpr size_t alarms_text_size() {
+  size_t size = 0;
+  for (const auto *messages : ALARM_EVENT_MESSAGES) {
+    for (uint8_t bit = 0; bit < 8; bit++)
+      size += std::char_traits<char>::length(messages[bit]) + 1;
+  }
+  return size;
+}
+
+static constexpr size_t ALARMS_TEXT_SIZE = alarms_text_size();
+
 static const uint16_t SEPLOS_BMS_SERVICE_UUID = 0xFF00;
 static const uint16_t SEPLOS_BMS_NOTIFY_CHARACTERISTIC_UUID = 0xFF01;   // handle 0x12
 static const uint16_t SEPLOS_BMS_CONTROL_CHARACTERISTIC_UUID = 0xFF02;  // handle 0x14
 
-static const uint16_t MAX_RESPONSE_SIZE = 200;
-
 static const uint16_t SEPLOS_PKT_START = 0x7E;
 static const uint16_t SEPLOS_PKT_END = 0x0D;
 
@@ -135,17 +141,23 @@ static const uint8_t SEPLOS_CMD_SET_BMS_PARAMETER = 0xA1;
 static const uint8_t SEPLOS_CMD_SET_DEVICE_GROUP_NUMBER_NAME = 0x65;
 static const uint8_t SEPLOS_CMD_SET_MOSFET_CONTROL = 0xAA;
 
+// Refresh policy of a queued command: requested every n-th poll cycle
+static const uint16_t SEPLOS_REFRESH_ONCE = 0;  // once per connection
+static const uint16_t SEPLOS_REFRESH_ALWAYS = 1;
+static const uint16_t SEPLOS_REFRESH_SETTINGS = 60;
+
 struct SeplosCommand {
   uint8_t function;
   std::vector<uint8_t> payload;
+  uint16_t refresh_cycles;
 };
 
-static const uint8_t SEPLOS_COMMAND_QUEUE_SIZE = 4;
+// Live data first: it is the only thing requested on every cycle
 static const SeplosCommand SEPLOS_COMMAND_QUEUE[SEPLOS_COMMAND_QUEUE_SIZE] = {
-    {SEPLOS_CMD_GET_SETTINGS, {0x00}},
-    {SEPLOS_CMD_GET_MANUFACTURER_INFO, {}},
-    {SEPLOS_CMD_GET_SINGLE_MACHINE_DATA, {0x00}},
-    {SEPLOS_CMD_GET_PARALLEL_DATA, {}}};
+    {SEPLOS_CMD_GET_SINGLE_MACHINE_DATA, {0x00}, SEPLOS_REFRESH_ALWAYS},
+    {SEPLOS_CMD_GET_PARALLEL_DATA, {}, SEPLOS_REFRESH_ALWAYS},
+    {SEPLOS_CMD_GET_SETTINGS, {0x00}, SEPLOS_REFRESH_SETTINGS},
+    {SEPLOS_CMD_GET_MANUFACTURER_INFO, {}, SEPLOS_REFRESH_ONCE}};
 
 #ifdef USE_ESP32
 void SeplosBmsBle::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
@@ -158,12 +170,20 @@ void SeplosBmsBle::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t
       this->node_state = espbt::ClientState::IDLE;
       this->publish_state_(this->online_status_binary_sensor_, false);
 
-      // Clear frame assembly state on disconnect
-      this->frame_buffer_.clear();
+      // Clear frame assembly and poll cycle state on disconnect
+      this->frame_length_ = 0;
       this->next_command_ = 0;
+      this->waiting_for_response_ = false;
+      this->mtu_ = BLE_DEFAULT_MTU;
+      this->poll_cycle_ = 0;
+      std::fill(std::begin(this->command_received_), std::end(this->command_received_), false);
+      // Republish the alarm state after reconnecting; the triggers fire only for alarms changed meanwhile
+      this->alarm_events_valid_ = false;
       break;
     }
     case ESP_GATTC_SEARCH_CMPL_EVT: {
+      // The handles are looked up after every service discovery. The ble_client runs it on each connect
+      // anyway, so caching them across reconnects would not start the polling any earlier
       // [esp32_ble_client:048]: [0] [60:6E:41:FF:FF:FF] Found device
       // [esp32_ble_client:064]: [0] [60:6E:41:FF:FF:FF] 0x00 Attempting BLE connection
       // [esp32_ble_client:192]: [0] [60:6E:41:FF:FF:FF] Service UUID: 0x1801
@@ -201,16 +221,25 @@ void SeplosBmsBle::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t
       this->char_command_handle_ = char_command->handle;
       break;
     }
+    case ESP_GATTC_CFG_MTU_EVT: {
+      // The MTU exchange is started by the BLE client after connecting, using the local MTU set in setup()
+      if (param->cfg_mtu.status == ESP_GATT_OK) {
+        this->on_mtu_negotiated_(param->cfg_mtu.mtu);
+      }
+      break;
+    }
     case ESP_GATTC_REG_FOR_NOTIFY_EVT: {
       this->node_state = espbt::ClientState::ESTABLISHED;
       this->publish_state_(this->online_status_binary_sensor_, true);
-      this->send_command(SEPLOS_COMMAND_QUEUE[0].function, SEPLOS_COMMAND_QUEUE[0].payload);
+      this->start_poll_cycle_(millis());
       break;
     }
     case ESP_GATTC_NOTIFY_EVT: {
       ESP_LOGVV(TAG, "Notification received: %s",
                 format_hex_pretty(param->notify.value, param->notify.value_len).c_str());  // NOLINT
 
+      // Already on the main loop task: esp32_ble queues the GATTC events of the Bluetooth stack and hands them
+      // to the clients from its loop(), so the frame is assembled and decoded right here
       this->assemble(param->notify.value, param->notify.value_len);
       break;
     }
@@ -226,72 +255,213 @@ void SeplosBmsBle::update() {
   }
 
   // Loop through all commands if connected
-  if (this->next_command_ != 0) {
+  this->start_poll_cycle_(millis());
+}
+
+void SeplosBmsBle::setup() {
+  // Global for all BLE clients of the node: the largest MTU of all instances is applied once
+  seplos_ble::apply_local_mtu();
+}
+#else
+void SeplosBmsBle::update() {}
+void SeplosBmsBle::setup() {}
+#endif  // USE_ESP32
+
+void SeplosBmsBle::on_mtu_negotiated_(uint16_t mtu) {
+  this->mtu_ = mtu;
+  const uint16_t payload = mtu - BLE_NOTIFY_OVERHEAD;
+  ESP_LOGI(TAG, "MTU %u negotiated (requested %u): %u bytes per notification, up to %u notifications per frame", mtu,
+           seplos_ble::get_local_mtu(), payload, (MAX_RESPONSE_SIZE + payload - 1) / payload);
+}
+
+void SeplosBmsBle::loop() { this->check_command_timeout_(millis()); }
+
+void SeplosBmsBle::start_poll_cycle_(uint32_t now) {
+  if (this->waiting_for_response_) {
     ESP_LOGW(TAG,
              "Command queue (%d of %d) was not completely processed. "
              "Please increase the update_interval if you see this warning frequently",
-             this->next_command_, SEPLOS_COMMAND_QUEUE_SIZE);
+             this->next_command_ + 1, SEPLOS_COMMAND_QUEUE_SIZE);
+    this->waiting_for_response_ = false;
+    this->poll_cycle_++;
   }
+
   this->next_command_ = 0;
-  this->send_command(SEPLOS_COMMAND_QUEUE[this->next_command_].function,
-                     SEPLOS_COMMAND_QUEUE[this->next_command_].payload);
-  this->next_command_++;
+  this->retries_ = 0;
+  this->cycle_start_ = now;
+  this->send_next_due_command_(now);
 }
-#else
-void SeplosBmsBle::update() {}
-#endif  // USE_ESP32
 
-void SeplosBmsBle::assemble(const uint8_t *data, uint16_t length) {
-  if (this->frame_buffer_.size() > MAX_RESPONSE_SIZE) {
-    ESP_LOGW(TAG, "Frame dropped because of invalid length");
-    this->frame_buffer_.clear();
+bool SeplosBmsBle::command_due_(uint8_t index) const {
+  const uint16_t refresh_cycles = SEPLOS_COMMAND_QUEUE[index].refresh_cycles;
+
+  // Everything is requested until it was answered once on this connection
+  if (!this->command_received_[index])
+    return true;
+
+  if (refresh_cycles == SEPLOS_REFRESH_ONCE)
+    return false;
+
+  return this->poll_cycle_ % refresh_cycles == 0;
+}
+
+void SeplosBmsBle::send_next_due_command_(uint32_t now) {
+  while (this->next_command_ < SEPLOS_COMMAND_QUEUE_SIZE && !this->command_due_(this->next_command_)) {
+    this->next_command_++;
+  }
+
+  if (this->next_command_ < SEPLOS_COMMAND_QUEUE_SIZE) {
+    this->send_queued_command_(now);
+    return;
+  }
+
+  ESP_LOGD(TAG, "Poll cycle %" PRIu32 " completed in %" PRIu32 " ms", this->poll_cycle_, now - this->cycle_start_);
+  for (uint8_t i = 0; i < SEPLOS_COMMAND_QUEUE_SIZE; i++) {
+    const SeplosCommandStats &stats = this->command_stats_[i];
+    ESP_LOGV(TAG,
+             "  Command 0x%02X: %" PRIu32 " requests, %" PRIu32 " responses, %" PRIu32 " timeouts, %" PRIu32
+             " skipped, latency %" PRIu32 " ms (avg %" PRIu32 " ms, max %" PRIu32 " ms)",
+             SEPLOS_COMMAND_QUEUE[i].function, stats.requests, stats.responses, stats.timeouts, stats.skipped,
+             stats.last_latency, stats.responses ? stats.total_latency / stats.responses : 0, stats.max_latency);
   }
+  this->poll_cycle_++;
+}
+
+void SeplosBmsBle::send_queued_command_(uint32_t now) {
+  const SeplosCommand &command = SEPLOS_COMMAND_QUEUE[this->next_command_];
+
+  this->command_stats_[this->next_command_].requests++;
+  this->waiting_for_response_ = true;
+  this->last_send_ = now;
+  this->send_command(command.function, command.payload);
+}
+
+void SeplosBmsBle::complete_command_(uint32_t now) {
+  SeplosCommandStats &stats = this->command_stats_[this->next_command_];
+  const uint32_t latency = now - this->last_send_;
 
+  stats.responses++;
+  stats.last_latency = latency;
+  stats.max_latency = std::max(stats.max_latency, latency);
+  stats.total_latency += latency;
+
+  this->command_received_[this->next_command_] = true;
+  this->waiting_for_response_ = false;
+  this->advance_command_queue_(now);
+}
+
+void SeplosBmsBle::check_command_timeout_(uint32_t now) {
+  if (!this->waiting_for_response_ || now - this->last_send_ < this->response_timeout_)
+    return;
+
+  const uint8_t function = SEPLOS_COMMAND_QUEUE[this->next_command_].function;
+  SeplosCommandStats &stats = this->command_stats_[this->next_command_];
+  stats.timeouts++;
+
+  if (this->retries_ < this->max_retries_) {
+    this->retries_++;
+    ESP_LOGD(TAG, "No response to command 0x%02X within %d ms. Retry %d of %d", function, this->response_timeout_,
+             this->retries_, this->max_retries_);
+    this->send_queued_command_(now);
+    return;
+  }
+
+  ESP_LOGW(TAG, "No response to command 0x%02X after %d attempts. Skipping it", function, this->retries_ + 1);
+  stats.skipped++;
+  this->waiting_for_response_ = false;
+  this->advance_command_queue_(now);
+}
+
+void SeplosBmsBle::advance_command_queue_(uint32_t now) {
+  this->retries_ = 0;
+  this->next_command_++;
+  this->send_next_due_command_(now);
+}
+
+void SeplosBmsBle::assemble(const uint8_t *data, uint16_t length) {
   // Flush buffer on every preamble (start of frame)
   if (length >= 1 && data[0] == SEPLOS_PKT_START) {
-    this->frame_buffer_.clear();
+    this->frame_length_ = 0;
   }
 
-  this->frame_buffer_.insert(this->frame_buffer_.end(), data, data + length);
+  const uint8_t *raw;
+  size_t available;
+  if (this->frame_length_ == 0 && length >= 7 && 7 + ((uint16_t(data[5]) << 8) | uint16_t(data[6])) + 3 <= length) {
+    // With a large MTU the whole frame arrives in one notification: it is validated and decoded without a copy
+    raw = data;
+    available = length;
+  } else {
+    if (this->frame_length_ + length > MAX_RESPONSE_SIZE) {
+      ESP_LOGW(TAG, "Frame dropped because of invalid length");
+      this->frame_length_ = 0;
+      return;
+    }
+
+    if (this->frame_length_ == 0) {
+      this->frame_crc_ = seplos_checksum::CRC16_XMODEM_INIT;
+      this->crc_position_ = 1;
+    }
+
+    memcpy(this->frame_buffer_ + this->frame_length_, data, length);
+    this->frame_length_ += length;
+    raw = this->frame_buffer_;
+    available = this->frame_length_;
 
-  if (this->frame_buffer_.size() >= 7) {
-    const uint8_t *raw = &this->frame_buffer_[0];
+    // The CRC covers everything after the start byte up to the CRC field and is hashed chunk by chunk
+    size_t crc_end = available;
+    if (available >= 7) {
+      crc_end = std::min<size_t>(available, 7 + ((uint16_t(raw[5]) << 8) | uint16_t(raw[6])));
+    }
+    this->update_frame_crc_(crc_end);
+  }
 
+  if (available >= 7) {
     uint16_t data_len = (uint16_t(raw[5]) << 8) | uint16_t(raw[6]);
     size_t frame_len = 7 + data_len + 2 + 1;  // header + payload + CRC + EOF
 
     if (frame_len > MAX_RESPONSE_SIZE) {
       ESP_LOGW(TAG, "Frame too large: %zu bytes", frame_len);
-      this->frame_buffer_.clear();
+      this->frame_length_ = 0;
       return;
     }
 
     // Check if we have received the expected complete frame
-    if (this->frame_buffer_.size() >= frame_len) {
+    if (available >= frame_len) {
       // Verify frame ends with SEPLOS_PKT_END at expected position
       if (raw[frame_len - 1] == SEPLOS_PKT_END) {
         // Validate CRC (last 2 bytes before end marker)
-        uint16_t computed_crc = crc_xmodem(raw + 1, frame_len - 4);  // Exclude start, CRC, and end
+        // Exclude start, CRC, and end
+        uint16_t computed_crc = raw == this->frame_buffer_ ? this->update_frame_crc_(frame_len - 3)
+                                                           : seplos_checksum::crc16_xmodem(raw + 1, frame_len - 4);
         uint16_t remote_crc = (uint16_t(raw[frame_len - 3]) << 8) | uint16_t(raw[frame_len - 2]);
 
         if (computed_crc != remote_crc) {
           ESP_LOGW(TAG, "CRC check failed! 0x%04X != 0x%04X", computed_crc, remote_crc);
-          this->frame_buffer_.clear();
+          this->frame_length_ = 0;
           return;
         }
 
-        std::vector<uint8_t> data(raw, raw + frame_len);
-        this->decode(data);
-        this->frame_buffer_.clear();
+        // The frame is decoded in place; the buffer is reused once decode() returns
+        this->decode(ByteView(raw, frame_len));
+        this->frame_length_ = 0;
       } else {
         ESP_LOGW(TAG, "Frame end marker missing at expected position %zu", frame_len - 1);
-        this->frame_buffer_.clear();
+        this->frame_length_ = 0;
       }
     }
   }
 }
 
-void SeplosBmsBle::decode(const std::vector<uint8_t> &data) {
+uint16_t SeplosBmsBle::update_frame_crc_(size_t end) {
+  if (end > this->crc_position_) {
+    this->frame_crc_ = seplos_checksum::crc16_xmodem_update(this->frame_crc_, this->frame_buffer_ + this->crc_position_,
+                                                            end - this->crc_position_);
+    this->crc_position_ = end;
+  }
+  return this->frame_crc_;
+}
+
+void SeplosBmsBle::decode(ByteView data) {
   uint8_t function = data[3];
 
   switch (function) {
@@ -325,7 +495,7 @@ void SeplosBmsBle::decode(const std::vector<uint8_t> &data) {
       break;
     case SEPLOS_CMD_SET_MOSFET_CONTROL:
       ESP_LOGI(TAG, "Switch control response (%zu bytes) received", data.size());
-      ESP_LOGD(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
+      ESP_LOGVV(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
       if (data.size() >= 9) {
         uint8_t result = data[7];
         ESP_LOGI(TAG, "Switch control result: %s", result == 0x00 ? "SUCCESS" : "FAILED");
@@ -336,17 +506,15 @@ void SeplosBmsBle::decode(const std::vector<uint8_t> &data) {
                format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
   }
 
-  // Send next command after each received frame
-  if (this->next_command_ < SEPLOS_COMMAND_QUEUE_SIZE) {
-    this->send_command(SEPLOS_COMMAND_QUEUE[this->next_command_].function,
-                       SEPLOS_COMMAND_QUEUE[this->next_command_].payload);
-    this->next_command_++;
+  // Send the next command once the pending one is answered
+  if (this->waiting_for_response_ && function == SEPLOS_COMMAND_QUEUE[this->next_command_].function) {
+    this->complete_command_(millis());
   }
 }
 
-void SeplosBmsBle::decode_manufacturer_info_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsBle::decode_manufacturer_info_data_(ByteView data) {
   ESP_LOGI(TAG, "Hardware version frame (%zu bytes) received", data.size());
-  ESP_LOGD(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
+  ESP_LOGVV(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
 
   // Expected frame size: 7 (header) + 35 (data) + 2 (CRC) + 1 (EOF) = 45 bytes
   if (data.size() < 45) {
@@ -443,264 +611,208 @@ std::string SeplosBmsBle::interpret_battery_type(uint8_t value) {
   }
 }
 
-void SeplosBmsBle::decode_settings_data_(const std::vector<uint8_t> &data) {
-  auto seplos_get_16bit = [&](size_t i) -> uint16_t { return (uint16_t(data[i]) << 8) | uint16_t(data[i + 1]); };
+// Protection thresholds and parameters of the settings frame (function 0x47), in the order of
+// SeplosSettings::values and the settings sensors
+struct SeplosSettingDescriptor {
+  const char *name;
+  uint8_t offset;
+  uint8_t width;
+  float factor;
+  float add;
+  uint8_t accuracy;
+  const char *unit;
+};
+
+static const SeplosSettingDescriptor SETTINGS[SEPLOS_SETTINGS_COUNT] = {
+    // Cell voltage (1 mV)
+    {"Single high voltage alarm", 9, 2, 0.001f, 0.0f, 3, "V"},
+    {"Single high pressure recovery", 11, 2, 0.001f, 0.0f, 3, "V"},
+    {"Single unit low voltage alarm", 13, 2, 0.001f, 0.0f, 3, "V"},
+    {"Single unit low pressure recovery", 15, 2, 0.001f, 0.0f, 3, "V"},
+    {"Single unit overvoltage protection", 17, 2, 0.001f, 0.0f, 3, "V"},
+    {"Cell overvoltage recovery", 19, 2, 0.001f, 0.0f, 3, "V"},
+    {"Single unit under voltage protection", 21, 2, 0.001f, 0.0f, 3, "V"},
+    {"Single unit undervoltage recovery", 23, 2, 0.001f, 0.0f, 3, "V"},
+    {"Balanced turn-on voltage", 25, 2, 0.001f, 0.0f, 3, "V"},
+    {"Battery cell low voltage charging is prohibited", 27, 2, 0.001f, 0.0f, 3, "V"},
+
+    // Total voltage (10 mV)
+    {"Total pressure high pressure alarm", 29, 2, 0.01f, 0.0f, 2, "V"},
+    {"Total pressure high pressure recovery", 31, 2, 0.01f, 0.0f, 2, "V"},
+    {"Low total pressure alarm", 33, 2, 0.01f, 0.0f, 2, "V"},
+    {"Total pressure low pressure recovery", 35, 2, 0.01f, 0.0f, 2, "V"},
+    {"Total voltage overvoltage protection", 37, 2, 0.01f, 0.0f, 2, "V"},
+    {"Total pressure overvoltage recovery", 39, 2, 0.01f, 0.0f, 2, "V"},
+    {"Total voltage undervoltage protection", 41, 2, 0.01f, 0.0f, 2, "V"},
+    {"Total voltage and undervoltage recovery", 43, 2, 0.01f, 0.0f, 2, "V"},
+    {"Charging overvoltage protection", 45, 2, 0.01f, 0.0f, 2, "V"},
+    {"Charging overvoltage recovery", 47, 2, 0.01f, 0.0f, 2, "V"},
+
+    // Temperature (0.1 K)
+    {"Charging high temperature alarm", 49, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Charging high temperature recovery", 51, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Charging low temperature alarm", 53, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Charging low temperature recovery", 55, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Charging over-temperature protection", 57, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Charging over-temperature recovery", 59, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Charging under-temperature protection", 61, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Charging under-temperature recovery", 63, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Discharge high temperature alarm", 65, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Discharge high temperature recovery", 67, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Discharge low temperature alarm", 69, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Discharge low temperature recovery", 71, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Discharge over temperature protection", 73, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Discharge over-temperature recovery", 75, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Discharge under-temperature protection", 77, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Discharge under-temperature recovery", 79, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Battery core low temperature heating", 81, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Battery cell low temperature recovery", 83, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Environmental high temperature alarm", 85, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Environmental high temperature recovery", 87, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Environmental low temperature alarm", 89, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Ambient low temperature recovery", 91, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Environmental over-temperature protection", 93, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Environment over-temperature recovery", 95, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Environmental under-temperature protection", 97, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Environmental low temperature recovery", 99, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Power high temperature alarm", 101, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Power high temperature recovery", 103, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Power over temperature protection", 105, 2, 0.1f, -273.15f, 1, "°C"},
+    {"Power over temperature recovery", 107, 2, 0.1f, -273.15f, 1, "°C"},
+
+    // Current (10 mA)
+    {"Charging overcurrent alarm", 109, 2, 0.01f, 0.0f, 2, "A"},
+    {"Charging overcurrent recovery", 111, 2, 0.01f, 0.0f, 2, "A"},
+    {"Discharge overcurrent alarm", 113, 2, 0.01f, 0.0f, 2, "A"},
+    {"Discharge overcurrent recovery", 115, 2, 0.01f, 0.0f, 2, "A"},
+    {"Charging overcurrent protection", 117, 2, 0.01f, 0.0f, 2, "A"},
+    {"Discharge overcurrent protection", 119, 2, 0.01f, 0.0f, 2, "A"},
+    {"Transient overcurrent protection", 121, 2, 0.01f, 0.0f, 2, "A"},
+
+    // Timing and capacity
+    {"Output soft start delay", 123, 2, 1.0f, 0.0f, 0, "ms"},
+    {"Battery rated capacity", 125, 2, 0.01f, 0.0f, 2, "Ah"},
+    {"Battery remaining capacity", 127, 2, 0.01f, 0.0f, 2, "Ah"},
+
+    // 1-byte parameters
+    {"Cell failure voltage difference", 130, 1, 0.01f, 0.0f, 2, "V"},
+    {"Battery failure recovery", 131, 1, 0.01f, 0.0f, 2, "V"},
+    {"Equilibrium opening pressure difference", 132, 1, 0.001f, 0.0f, 3, "V"},
+    {"Equalization end pressure difference", 133, 1, 0.001f, 0.0f, 3, "V"},
+    {"Static equilibrium time", 134, 1, 1.0f, 0.0f, 0, "h"},
+    {"Number of battery cells in series", 135, 1, 1.0f, 0.0f, 0, ""},
+};
+
+static const uint8_t SETTINGS_FUNCTION_SWITCHES_OFFSET = 136;
+
+static const char *const FUNCTION_SWITCHES[SEPLOS_FUNCTION_SWITCH_COUNT][8] = {
+    {"Voltage sensing failure", "Temperature sensing failure", "Current sensing failure", "Key switch failure",
+     "Cell voltage difference failure", "Charging switch failure", "Discharge switch failure",
+     "Current limit switch failure"},
+    {"Single high voltage alarm", "Single overvoltage protection", "Single unit low voltage alarm",
+     "Single unit undervoltage protection", "Total pressure high voltage alarm", "Total voltage overvoltage protection",
+     "Total pressure low pressure alarm", "Total voltage undervoltage protection"},
+    {"Charging high temperature alarm", "Charging over-temperature protection", "Charging low temperature alarm",
+     "Charging under-temperature protection", "Discharge high temperature alarm",
+     "Discharge over-temperature protection", "Discharge low temperature alarm",
+     "Discharge under-temperature protection"},
+    {"Ambient high temperature alarm", "Environmental over-temperature protection", "Ambient low temperature alarm",
+     "Environmental under-temperature protection", "Power over-temperature protection",
+     "Power high temperature alarm", "Battery core low-temperature heating", "Secondary trip protection"},
+    {"Charging overcurrent alarm", "Charging overcurrent protection", "Discharge overcurrent alarm",
+     "Discharge overcurrent protection", "Transient overcurrent protection", "Output short circuit protection",
+     "Transient overcurrent lockout", "Output short circuit lockout"},
+    {"Charging high voltage protection", "Intermittent power supply function", "Remaining capacity alarm",
+     "Remaining capacity protection", "Battery cell low voltage charging prohibited",
+     "Output reverse polarity protection", "Output connection failure", "Output soft start function"},
+    {"Charge balancing function", "Static equalization function", "Timeout prohibits equalization",
+     "Over-temperature prohibition equalization", "Automatic activation of charging",
+     "Manual activation of charging", "Active current limiting charging", "Passive current limiting charging"},
+    {"Switch shutdown function", "Standby power-off function", "History function", "LCD display function",
+     "Bluetooth communication function", "Automatic address encoding", "Parallel external polling",
+     "Standalone 1.0C charging"},
+};
 
+void SeplosBmsBle::decode_settings_data_(ByteView data) {
   ESP_LOGI(TAG, "Settings frame (%zu bytes) received", data.size());
-  ESP_LOGD(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
+  ESP_LOGVV(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
 
   if (data.size() < 145) {
     ESP_LOGW(TAG, "Settings frame too short (%zu bytes)", data.size());
     return;
   }
 
-  // uint16_t data_len = seplos_get_16bit(5);
-  ESP_LOGD(TAG, "Group number: %d", data[7]);
-  ESP_LOGD(TAG, "Parameter count: %d", data[8]);
-
-  // Voltage parameters
-  ESP_LOGD(TAG, "Single high voltage alarm: %.3f V", seplos_get_16bit(9) * 0.001f);
-  ESP_LOGD(TAG, "Single high pressure recovery: %.3f V", seplos_get_16bit(11) * 0.001f);
-  ESP_LOGD(TAG, "Single unit low voltage alarm: %.3f V", seplos_get_16bit(13) * 0.001f);
-  ESP_LOGD(TAG, "Single unit low pressure recovery: %.3f V", seplos_get_16bit(15) * 0.001f);
-  ESP_LOGD(TAG, "Single unit overvoltage protection: %.3f V", seplos_get_16bit(17) * 0.001f);
-  ESP_LOGD(TAG, "Cell overvoltage recovery: %.3f V", seplos_get_16bit(19) * 0.001f);
-  ESP_LOGD(TAG, "Single unit under voltage protection: %.3f V", seplos_get_16bit(21) * 0.001f);
-  ESP_LOGD(TAG, "Single unit undervoltage recovery: %.3f V", seplos_get_16bit(23) * 0.001f);
-  ESP_LOGD(TAG, "Balanced turn-on voltage: %.3f V", seplos_get_16bit(25) * 0.001f);
-  ESP_LOGD(TAG, "Battery cell low voltage charging is prohibited: %.3f V", seplos_get_16bit(27) * 0.001f);
-
-  // Total voltage parameters
-  ESP_LOGD(TAG, "Total pressure high pressure alarm: %.2f V", seplos_get_16bit(29) * 0.01f);
-  ESP_LOGD(TAG, "Total pressure high pressure recovery: %.2f V", seplos_get_16bit(31) * 0.01f);
-  ESP_LOGD(TAG, "Low total pressure alarm: %.2f V", seplos_get_16bit(33) * 0.01f);
-  ESP_LOGD(TAG, "Total pressure low pressure recovery: %.2f V", seplos_get_16bit(35) * 0.01f);
-  ESP_LOGD(TAG, "Total voltage overvoltage protection: %.2f V", seplos_get_16bit(37) * 0.01f);
-  ESP_LOGD(TAG, "Total pressure overvoltage recovery: %.2f V", seplos_get_16bit(39) * 0.01f);
-  ESP_LOGD(TAG, "Total voltage undervoltage protection: %.2f V", seplos_get_16bit(41) * 0.01f);
-  ESP_LOGD(TAG, "Total voltage and undervoltage recovery: %.2f V", seplos_get_16bit(43) * 0.01f);
-  ESP_LOGD(TAG, "Charging overvoltage protection: %.2f V", seplos_get_16bit(45) * 0.01f);
-  ESP_LOGD(TAG, "Charging overvoltage recovery: %.2f V", seplos_get_16bit(47) * 0.01f);
-
-  // Temperature parameters
-  ESP_LOGD(TAG, "Charging high temperature alarm: %.1f °C", seplos_get_16bit(49) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Charging high temperature recovery: %.1f °C", seplos_get_16bit(51) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Charging low temperature alarm: %.1f °C", seplos_get_16bit(53) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Charging low temperature recovery: %.1f °C", seplos_get_16bit(55) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Charging over-temperature protection: %.1f °C", seplos_get_16bit(57) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Charging over-temperature recovery: %.1f °C", seplos_get_16bit(59) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Charging under-temperature protection: %.1f °C", seplos_get_16bit(61) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Charging under-temperature recovery: %.1f °C", seplos_get_16bit(63) * 0.1f - 273.15f);
-
-  ESP_LOGD(TAG, "Discharge high temperature alarm: %.1f °C", seplos_get_16bit(65) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Discharge high temperature recovery: %.1f °C", seplos_get_16bit(67) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Discharge low temperature alarm: %.1f °C", seplos_get_16bit(69) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Discharge low temperature recovery: %.1f °C", seplos_get_16bit(71) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Discharge over temperature protection: %.1f °C", seplos_get_16bit(73) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Discharge over-temperature recovery: %.1f °C", seplos_get_16bit(75) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Discharge under-temperature protection: %.1f °C", seplos_get_16bit(77) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Discharge under-temperature recovery: %.1f °C", seplos_get_16bit(79) * 0.1f - 273.15f);
-
-  ESP_LOGD(TAG, "Battery core low temperature heating: %.1f °C", seplos_get_16bit(81) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Battery cell low temperature recovery: %.1f °C", seplos_get_16bit(83) * 0.1f - 273.15f);
-
-  ESP_LOGD(TAG, "Environmental high temperature alarm: %.1f °C", seplos_get_16bit(85) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Environmental high temperature recovery: %.1f °C", seplos_get_16bit(87) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Environmental low temperature alarm: %.1f °C", seplos_get_16bit(89) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Ambient low temperature recovery: %.1f °C", seplos_get_16bit(91) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Environmental over-temperature protection: %.1f °C", seplos_get_16bit(93) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Environment over-temperature recovery: %.1f °C", seplos_get_16bit(95) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Environmental under-temperature protection: %.1f °C", seplos_get_16bit(97) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Environmental low temperature recovery: %.1f °C", seplos_get_16bit(99) * 0.1f - 273.15f);
-
-  ESP_LOGD(TAG, "Power high temperature alarm: %.1f °C", seplos_get_16bit(101) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Power high temperature recovery: %.1f °C", seplos_get_16bit(103) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Power over temperature protection: %.1f °C", seplos_get_16bit(105) * 0.1f - 273.15f);
-  ESP_LOGD(TAG, "Power over temperature recovery: %.1f °C", seplos_get_16bit(107) * 0.1f - 273.15f);
-
-  // Current parameters (0.01A)
-  ESP_LOGD(TAG, "Charging overcurrent alarm: %.2f A", seplos_get_16bit(109) * 0.01f);
-  ESP_LOGD(TAG, "Charging overcurrent recovery: %.2f A", seplos_get_16bit(111) * 0.01f);
-  ESP_LOGD(TAG, "Discharge overcurrent alarm: %.2f A", seplos_get_16bit(113) * 0.01f);
-  ESP_LOGD(TAG, "Discharge overcurrent recovery: %.2f A", seplos_get_16bit(115) * 0.01f);
-  ESP_LOGD(TAG, "Charging overcurrent protection: %.2f A", seplos_get_16bit(117) * 0.01f);
-  ESP_LOGD(TAG, "Discharge overcurrent protection: %.2f A", seplos_get_16bit(119) * 0.01f);
-  ESP_LOGD(TAG, "Transient overcurrent protection: %.2f A", seplos_get_16bit(121) * 0.01f);
-
-  // Timing and capacity
-  ESP_LOGD(TAG, "Output soft start delay: %d ms", seplos_get_16bit(123));
-  ESP_LOGD(TAG, "Battery rated capacity: %.2f Ah", seplos_get_16bit(125) * 0.01f);
-  ESP_LOGD(TAG, "Battery remaining capacity: %.2f Ah", seplos_get_16bit(127) * 0.01f);
-
-  // 1-byte parameters
-  ESP_LOGD(TAG, "Cell failure voltage difference: %.2f V", data[130] * 0.01f);
-  ESP_LOGD(TAG, "Battery failure recovery: %.2f V", data[131] * 0.01f);
-  ESP_LOGD(TAG, "Equilibrium opening pressure difference: %.3f V", data[132] * 0.001f);
-  ESP_LOGD(TAG, "Equalization end pressure difference: %.3f V", data[133] * 0.001f);
-  ESP_LOGD(TAG, "Static equilibrium time: %d h", data[134]);
-  ESP_LOGD(TAG, "Number of battery cells in series: %d", data[135]);
-
-  // Function switches with detailed bitmask interpretation
-  uint8_t switch1 = data[136];
-  ESP_LOGD(TAG, "Function switch 1: 0x%02X", switch1);
-  if (switch1 & 0x01)
-    ESP_LOGD(TAG, "  - Voltage sensing failure enabled");
-  if (switch1 & 0x02)
-    ESP_LOGD(TAG, "  - Temperature sensing failure enabled");
-  if (switch1 & 0x04)
-    ESP_LOGD(TAG, "  - Current sensing failure enabled");
-  if (switch1 & 0x08)
-    ESP_LOGD(TAG, "  - Key switch failure enabled");
-  if (switch1 & 0x10)
-    ESP_LOGD(TAG, "  - Cell voltage difference failure enabled");
-  if (switch1 & 0x20)
-    ESP_LOGD(TAG, "  - Charging switch failure enabled");
-  if (switch1 & 0x40)
-    ESP_LOGD(TAG, "  - Discharge switch failure enabled");
-  if (switch1 & 0x80)
-    ESP_LOGD(TAG, "  - Current limit switch failure enabled");
-
-  uint8_t switch2 = data[137];
-  ESP_LOGD(TAG, "Function switch 2: 0x%02X", switch2);
-  if (switch2 & 0x01)
-    ESP_LOGD(TAG, "  - Single high voltage alarm enabled");
-  if (switch2 & 0x02)
-    ESP_LOGD(TAG, "  - Single overvoltage protection enabled");
-  if (switch2 & 0x04)
-    ESP_LOGD(TAG, "  - Single unit low voltage alarm enabled");
-  if (switch2 & 0x08)
-    ESP_LOGD(TAG, "  - Single unit undervoltage protection enabled");
-  if (switch2 & 0x10)
-    ESP_LOGD(TAG, "  - Total pressure high voltage alarm enabled");
-  if (switch2 & 0x20)
-    ESP_LOGD(TAG, "  - Total voltage overvoltage protection enabled");
-  if (switch2 & 0x40)
-    ESP_LOGD(TAG, "  - Total pressure low pressure alarm enabled");
-  if (switch2 & 0x80)
-    ESP_LOGD(TAG, "  - Total voltage undervoltage protection enabled");
-
-  uint8_t switch3 = data[138];
-  ESP_LOGD(TAG, "Function switch 3: 0x%02X", switch3);
-  if (switch3 & 0x01)
-    ESP_LOGD(TAG, "  - Charging high temperature alarm enabled");
-  if (switch3 & 0x02)
-    ESP_LOGD(TAG, "  - Charging over-temperature protection enabled");
-  if (switch3 & 0x04)
-    ESP_LOGD(TAG, "  - Charging low temperature alarm enabled");
-  if (switch3 & 0x08)
-    ESP_LOGD(TAG, "  - Charging under-temperature protection enabled");
-  if (switch3 & 0x10)
-    ESP_LOGD(TAG, "  - Discharge high temperature alarm enabled");
-  if (switch3 & 0x20)
-    ESP_LOGD(TAG, "  - Discharge over-temperature protection enabled");
-  if (switch3 & 0x40)
-    ESP_LOGD(TAG, "  - Discharge low temperature alarm enabled");
-  if (switch3 & 0x80)
-    ESP_LOGD(TAG, "  - Discharge under-temperature protection enabled");
-
-  uint8_t switch4 = data[139];
-  ESP_LOGD(TAG, "Function switch 4: 0x%02X", switch4);
-  if (switch4 & 0x01)
-    ESP_LOGD(TAG, "  - Ambient high temperature alarm enabled");
-  if (switch4 & 0x02)
-    ESP_LOGD(TAG, "  - Environmental over-temperature protection enabled");
-  if (switch4 & 0x04)
-    ESP_LOGD(TAG, "  - Ambient low temperature alarm enabled");
-  if (switch4 & 0x08)
-    ESP_LOGD(TAG, "  - Environmental under-temperature protection enabled");
-  if (switch4 & 0x10)
-    ESP_LOGD(TAG, "  - Power over-temperature protection enabled");
-  if (switch4 & 0x20)
-    ESP_LOGD(TAG, "  - Power high temperature alarm enabled");
-  if (switch4 & 0x40)
-    ESP_LOGD(TAG, "  - Battery core low-temperature heating enabled");
-  if (switch4 & 0x80)
-    ESP_LOGD(TAG, "  - Secondary trip protection enabled");
-
-  uint8_t switch5 = data[140];
-  ESP_LOGD(TAG, "Function switch 5: 0x%02X", switch5);
-  if (switch5 & 0x01)
-    ESP_LOGD(TAG, "  - Charging overcurrent alarm enabled");
-  if (switch5 & 0x02)
-    ESP_LOGD(TAG, "  - Charging overcurrent protection enabled");
-  if (switch5 & 0x04)
-    ESP_LOGD(TAG, "  - Discharge overcurrent alarm enabled");
-  if (switch5 & 0x08)
-    ESP_LOGD(TAG, "  - Discharge overcurrent protection enabled");
-  if (switch5 & 0x10)
-    ESP_LOGD(TAG, "  - Transient overcurrent protection enabled");
-  if (switch5 & 0x20)
-    ESP_LOGD(TAG, "  - Output short circuit protection enabled");
-  if (switch5 & 0x40)
-    ESP_LOGD(TAG, "  - Transient overcurrent lockout enabled");
-  if (switch5 & 0x80)
-    ESP_LOGD(TAG, "  - Output short circuit lockout enabled");
-
-  uint8_t switch6 = data[141];
-  ESP_LOGD(TAG, "Function switch 6: 0x%02X", switch6);
-  if (switch6 & 0x01)
-    ESP_LOGD(TAG, "  - Charging high voltage protection enabled");
-  if (switch6 & 0x02)
-    ESP_LOGD(TAG, "  - Intermittent power supply function enabled");
-  if (switch6 & 0x04)
-    ESP_LOGD(TAG, "  - Remaining capacity alarm enabled");
-  if (switch6 & 0x08)
-    ESP_LOGD(TAG, "  - Remaining capacity protection enabled");
-  if (switch6 & 0x10)
-    ESP_LOGD(TAG, "  - Battery cell low voltage charging prohibited enabled");
-  if (switch6 & 0x20)
-    ESP_LOGD(TAG, "  - Output reverse polarity protection enabled");
-  if (switch6 & 0x40)
-    ESP_LOGD(TAG, "  - Output connection failure enabled");
-  if (switch6 & 0x80)
-    ESP_LOGD(TAG, "  - Output soft start function enabled");
-
-  uint8_t switch7 = data[142];
-  ESP_LOGD(TAG, "Function switch 7: 0x%02X", switch7);
-  if (switch7 & 0x01)
-    ESP_LOGD(TAG, "  - Charge balancing function enabled");
-  if (switch7 & 0x02)
-    ESP_LOGD(TAG, "  - Static equalization function enabled");
-  if (switch7 & 0x04)
-    ESP_LOGD(TAG, "  - Timeout prohibits equalization enabled");
-  if (switch7 & 0x08)
-    ESP_LOGD(TAG, "  - Over-temperature prohibition equalization enabled");
-  if (switch7 & 0x10)
-    ESP_LOGD(TAG, "  - Automatic activation of charging enabled");
-  if (switch7 & 0x20)
-    ESP_LOGD(TAG, "  - Manual activation of charging enabled");
-  if (switch7 & 0x40)
-    ESP_LOGD(TAG, "  - Active current limiting charging enabled");
-  if (switch7 & 0x80)
-    ESP_LOGD(TAG, "  - Passive current limiting charging enabled");
-
-  uint8_t switch8 = data[143];
-  ESP_LOGD(TAG, "Function switch 8: 0x%02X", switch8);
-  if (switch8 & 0x01)
-    ESP_LOGD(TAG, "  - Switch shutdown function enabled");
-  if (switch8 & 0x02)
-    ESP_LOGD(TAG, "  - Standby power-off function enabled");
-  if (switch8 & 0x04)
-    ESP_LOGD(TAG, "  - History function enabled");
-  if (switch8 & 0x08)
-    ESP_LOGD(TAG, "  - LCD display function enabled");
-  if (switch8 & 0x10)
-    ESP_LOGD(TAG, "  - Bluetooth communication function enabled");
-  if (switch8 & 0x20)
-    ESP_LOGD(TAG, "  - Automatic address encoding enabled");
-  if (switch8 & 0x40)
-    ESP_LOGD(TAG, "  - Parallel external polling enabled");
-  if (switch8 & 0x80)
-    ESP_LOGD(TAG, "  - Standalone 1.0C charging enabled");
+  // The settings rarely change: the frame is decoded into a raw snapshot and only the values which
+  // differ from the previous snapshot are published and logged
+  SeplosSettings settings;
+  for (uint8_t i = 0; i < SEPLOS_SETTINGS_COUNT; i++) {
+    const SeplosSettingDescriptor &setting = SETTINGS[i];
+    settings.values[i] = setting.width == 2
+                             ? (uint16_t(data[setting.offset]) << 8) | uint16_t(data[setting.offset + 1])
+                             : data[setting.offset];
+  }
+  std::memcpy(settings.function_switches, &data[SETTINGS_FUNCTION_SWITCHES_OFFSET], SEPLOS_FUNCTION_SWITCH_COUNT);
+
+  const bool initial = !this->settings_valid_;
+  if (initial) {
+    ESP_LOGD(TAG, "Group number: %d", data[7]);
+    ESP_LOGD(TAG, "Parameter count: %d", data[8]);
+  }
+
+  uint8_t changes = 0;
+  for (uint8_t i = 0; i < SEPLOS_SETTINGS_COUNT; i++) {
+    if (!initial && settings.values[i] == this->settings_.values[i])
+      continue;
+
+    const SeplosSettingDescriptor &setting = SETTINGS[i];
+    const float value = settings.values[i] * setting.factor + setting.add;
+    if (initial) {
+      ESP_LOGD(TAG, "%s: %.*f %s", setting.name, setting.accuracy, value, setting.unit);
+    } else {
+      const float previous = this->settings_.values[i] * setting.factor + setting.add;
+      ESP_LOGI(TAG, "%s changed: %.*f %s -> %.*f %s", setting.name, setting.accuracy, previous, setting.unit,
+               setting.accuracy, value, setting.unit);
+    }
+    this->publish_state_(this->setting_sensors_[i], value);
+    changes++;
+  }
+
+  for (uint8_t i = 0; i < SEPLOS_FUNCTION_SWITCH_COUNT; i++) {
+    const uint8_t switches = settings.function_switches[i];
+    const uint8_t changed = initial ? 0xFF : switches ^ this->settings_.function_switches[i];
+    if (changed == 0)
+      continue;
+
+    if (initial)
+      ESP_LOGD(TAG, "Function switch %d: 0x%02X", i + 1, switches);
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      if ((changed & (1 << bit)) == 0)
+        continue;
+      const bool enabled = (switches & (1 << bit)) != 0;
+      if (initial) {
+        if (enabled)
+          ESP_LOGD(TAG, "  - %s enabled", FUNCTION_SWITCHES[i][bit]);
+      } else {
+        ESP_LOGI(TAG, "%s %s", FUNCTION_SWITCHES[i][bit], enabled ? "enabled" : "disabled");
+      }
+    }
+    changes++;
+  }
+
+  if (!initial && changes == 0)
+    ESP_LOGD(TAG, "Settings unchanged");
+
+  this->settings_ = settings;
+  this->settings_valid_ = true;
 }
 
-void SeplosBmsBle::decode_parallel_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsBle::decode_parallel_data_(ByteView data) {
   auto seplos_get_16bit = [&](size_t i) -> uint16_t {
     return (uint16_t(data[i + 0]) << 8) | (uint16_t(data[i + 1]) << 0);
   };
 
   ESP_LOGI(TAG, "Parallel data frame (%zu bytes) received", data.size());
-  ESP_LOGD(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
+  ESP_LOGVV(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
 
   if (data.size() < 58) {
     ESP_LOGW(TAG, "Parallel data frame too short (%zu bytes)", data.size());
@@ -863,13 +975,13 @@ void SeplosBmsBle::decode_parallel_data_(const std::vector<uint8_t> &data) {
   }
 }
 
-void SeplosBmsBle::decode_single_machine_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsBle::decode_single_machine_data_(ByteView data) {
   auto seplos_get_16bit = [&](size_t i) -> uint16_t {
     return (uint16_t(data[i + 0]) << 8) | (uint16_t(data[i + 1]) << 0);
   };
 
   ESP_LOGI(TAG, "Status frame (%zu bytes) received", data.size());
-  ESP_LOGD(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
+  ESP_LOGVV(TAG, "  %s", format_hex_pretty(&data.front(), data.size()).c_str());  // NOLINT
 
   if (data.size() < 60) {
     ESP_LOGW(TAG, "Status frame too short (%zu bytes)", data.size());
@@ -1024,113 +1136,12 @@ void SeplosBmsBle::decode_single_machine_data_(const std::vector<uint8_t> &data)
 
   size_t alarm_offset = protection_offset + 5;
 
-  // Alarm event1 - Hardware failures
-  uint8_t alarm_event1 = data[alarm_offset + 0];
-  ESP_LOGD(TAG, "Alarm event 1: 0x%02X", alarm_event1);
-  ESP_LOGD(TAG, "  Bit0 Voltage sensing failure: %s", ONOFF(alarm_event1 & 0x01));
-  ESP_LOGD(TAG, "  Bit1 Temperature sensing failure: %s", ONOFF(alarm_event1 & 0x02));
-  ESP_LOGD(TAG, "  Bit2 Current sensing failure: %s", ONOFF(alarm_event1 & 0x04));
-  ESP_LOGD(TAG, "  Bit3 Key switch failure: %s", ONOFF(alarm_event1 & 0x08));
-  ESP_LOGD(TAG, "  Bit4 Cell voltage difference failure: %s", ONOFF(alarm_event1 & 0x10));
-  ESP_LOGD(TAG, "  Bit5 Charging switch failed: %s", ONOFF(alarm_event1 & 0x20));
-  ESP_LOGD(TAG, "  Bit6 Discharge switch failure: %s", ONOFF(alarm_event1 & 0x40));
-  ESP_LOGD(TAG, "  Bit7 Current limit switch failure: %s", ONOFF(alarm_event1 & 0x80));
-  this->publish_state_(this->alarm_event1_bitmask_sensor_, (float) alarm_event1);
-
-  // Alarm event2 - Voltage alarms
-  uint8_t alarm_event2 = data[alarm_offset + 1];
-  ESP_LOGD(TAG, "Alarm event 2: 0x%02X", alarm_event2);
-  ESP_LOGD(TAG, "  Bit0 Single high voltage alarm: %s", ONOFF(alarm_event2 & 0x01));
-  ESP_LOGD(TAG, "  Bit1 Single unit overvoltage protection: %s", ONOFF(alarm_event2 & 0x02));
-  ESP_LOGD(TAG, "  Bit2 Single unit low voltage alarm: %s", ONOFF(alarm_event2 & 0x04));
-  ESP_LOGD(TAG, "  Bit3 Single unit under voltage protection: %s", ONOFF(alarm_event2 & 0x08));
-  ESP_LOGD(TAG, "  Bit4 Total pressure high pressure alarm: %s", ONOFF(alarm_event2 & 0x10));
-  ESP_LOGD(TAG, "  Bit5 Total voltage overvoltage protection: %s", ONOFF(alarm_event2 & 0x20));
-  ESP_LOGD(TAG, "  Bit6 Low total pressure alarm: %s", ONOFF(alarm_event2 & 0x40));
-  ESP_LOGD(TAG, "  Bit7 Total voltage undervoltage protection: %s", ONOFF(alarm_event2 & 0x80));
-  this->publish_state_(this->alarm_event2_bitmask_sensor_, (float) alarm_event2);
-
-  // Alarm event3 - Cell temperature
-  uint8_t alarm_event3 = data[alarm_offset + 2];
-  ESP_LOGD(TAG, "Alarm event 3: 0x%02X", alarm_event3);
-  ESP_LOGD(TAG, "  Bit0 Charging high temperature alarm: %s", ONOFF(alarm_event3 & 0x01));
-  ESP_LOGD(TAG, "  Bit1 Charging over-temperature protection: %s", ONOFF(alarm_event3 & 0x02));
-  ESP_LOGD(TAG, "  Bit2 Charging low temperature alarm: %s", ONOFF(alarm_event3 & 0x04));
-  ESP_LOGD(TAG, "  Bit3 Charging under-temperature protection: %s", ONOFF(alarm_event3 & 0x08));
-  ESP_LOGD(TAG, "  Bit4 Discharge high temperature alarm: %s", ONOFF(alarm_event3 & 0x10));
-  ESP_LOGD(TAG, "  Bit5 Discharge over temperature protection: %s", ONOFF(alarm_event3 & 0x20));
-  ESP_LOGD(TAG, "  Bit6 Discharge low temperature alarm: %s", ONOFF(alarm_event3 & 0x40));
-  ESP_LOGD(TAG, "  Bit7 Discharge under-temperature protection: %s", ONOFF(alarm_event3 & 0x80));
-  this->publish_state_(this->alarm_event3_bitmask_sensor_, (float) alarm_event3);
-
-  // Alarm event4 - Environmental/power temperature
-  uint8_t alarm_event4 = data[alarm_offset + 3];
-  ESP_LOGD(TAG, "Alarm event 4: 0x%02X", alarm_event4);
-  ESP_LOGD(TAG, "  Bit0 Environmental high temperature alarm: %s", ONOFF(alarm_event4 & 0x01));
-  ESP_LOGD(TAG, "  Bit1 Environmental over-temperature protection: %s", ONOFF(alarm_event4 & 0x02));
-  ESP_LOGD(TAG, "  Bit2 Environmental low temperature alarm: %s", ONOFF(alarm_event4 & 0x04));
-  ESP_LOGD(TAG, "  Bit3 Environmental under-temperature protection: %s", ONOFF(alarm_event4 & 0x08));
-  ESP_LOGD(TAG, "  Bit4 Power over temperature protection: %s", ONOFF(alarm_event4 & 0x10));
-  ESP_LOGD(TAG, "  Bit5 Power high temperature alarm: %s", ONOFF(alarm_event4 & 0x20));
-  ESP_LOGD(TAG, "  Bit6 Battery core low temperature heating: %s", ONOFF(alarm_event4 & 0x40));
-  ESP_LOGD(TAG, "  Bit7 Secondary trip protection: %s", ONOFF(alarm_event4 & 0x80));
-  this->publish_state_(this->alarm_event4_bitmask_sensor_, (float) alarm_event4);
-
-  // Alarm event5 - Current protection
-  uint8_t alarm_event5 = data[alarm_offset + 4];
-  ESP_LOGD(TAG, "Alarm event 5: 0x%02X", alarm_event5);
-  ESP_LOGD(TAG, "  Bit0 Charging overcurrent alarm: %s", ONOFF(alarm_event5 & 0x01));
-  ESP_LOGD(TAG, "  Bit1 Charging overcurrent protection: %s", ONOFF(alarm_event5 & 0x02));
-  ESP_LOGD(TAG, "  Bit2 Discharge overcurrent alarm: %s", ONOFF(alarm_event5 & 0x04));
-  ESP_LOGD(TAG, "  Bit3 Discharge overcurrent protection: %s", ONOFF(alarm_event5 & 0x08));
-  ESP_LOGD(TAG, "  Bit4 Transient overcurrent protection: %s", ONOFF(alarm_event5 & 0x10));
-  ESP_LOGD(TAG, "  Bit5 Output short circuit protection: %s", ONOFF(alarm_event5 & 0x20));
-  ESP_LOGD(TAG, "  Bit6 Transient overcurrent lockout: %s", ONOFF(alarm_event5 & 0x40));
-  ESP_LOGD(TAG, "  Bit7 Output short circuit lockout: %s", ONOFF(alarm_event5 & 0x80));
-  this->publish_state_(this->alarm_event5_bitmask_sensor_, (float) alarm_event5);
-
-  // Alarm event6 - Charging/output protection
-  uint8_t alarm_event6 = data[alarm_offset + 5];
-  ESP_LOGD(TAG, "Alarm event 6: 0x%02X", alarm_event6);
-  ESP_LOGD(TAG, "  Bit0 Charging high voltage protection: %s", ONOFF(alarm_event6 & 0x01));
-  ESP_LOGD(TAG, "  Bit1 Waiting for intermittent power replenishment: %s", ONOFF(alarm_event6 & 0x02));
-  ESP_LOGD(TAG, "  Bit2 Remaining capacity alarm: %s", ONOFF(alarm_event6 & 0x04));
-  ESP_LOGD(TAG, "  Bit3 Remaining capacity protection: %s", ONOFF(alarm_event6 & 0x08));
-  ESP_LOGD(TAG, "  Bit4 Battery cell low voltage charging is prohibited: %s", ONOFF(alarm_event6 & 0x10));
-  ESP_LOGD(TAG, "  Bit5 Output reverse polarity protection: %s", ONOFF(alarm_event6 & 0x20));
-  ESP_LOGD(TAG, "  Bit6 Output connection failure: %s", ONOFF(alarm_event6 & 0x40));
-  ESP_LOGD(TAG, "  Bit7 Internal alarm: %s", ONOFF(alarm_event6 & 0x80));
-  this->publish_state_(this->alarm_event6_bitmask_sensor_, (float) alarm_event6);
-
-  // Alarm event7 - Internal/charging waiting
-  uint8_t alarm_event7 = data[alarm_offset + 6];
-  ESP_LOGD(TAG, "Alarm event 7: 0x%02X", alarm_event7);
-  ESP_LOGD(TAG, "  Bit0 Internal: %s", ONOFF(alarm_event7 & 0x01));
-  ESP_LOGD(TAG, "  Bit1 Internal: %s", ONOFF(alarm_event7 & 0x02));
-  ESP_LOGD(TAG, "  Bit2 Internal: %s", ONOFF(alarm_event7 & 0x04));
-  ESP_LOGD(TAG, "  Bit3 Internal: %s", ONOFF(alarm_event7 & 0x08));
-  ESP_LOGD(TAG, "  Bit4 Automatic charging waiting: %s", ONOFF(alarm_event7 & 0x10));
-  ESP_LOGD(TAG, "  Bit5 Manual charging waiting: %s", ONOFF(alarm_event7 & 0x20));
-  ESP_LOGD(TAG, "  Bit6 Internal: %s", ONOFF(alarm_event7 & 0x40));
-  ESP_LOGD(TAG, "  Bit7 Internal: %s", ONOFF(alarm_event7 & 0x80));
-  this->publish_state_(this->alarm_event7_bitmask_sensor_, (float) alarm_event7);
-
-  // Alarm event8 - System/calibration failures
-  uint8_t alarm_event8 = data[alarm_offset + 7];
-  ESP_LOGD(TAG, "Alarm event 8: 0x%02X", alarm_event8);
-  ESP_LOGD(TAG, "  Bit0 EEP storage failure: %s", ONOFF(alarm_event8 & 0x01));
-  ESP_LOGD(TAG, "  Bit1 RTC clock failure: %s", ONOFF(alarm_event8 & 0x02));
-  ESP_LOGD(TAG, "  Bit2 Voltage calibration not done: %s", ONOFF(alarm_event8 & 0x04));
-  ESP_LOGD(TAG, "  Bit3 Current calibration not done: %s", ONOFF(alarm_event8 & 0x08));
-  ESP_LOGD(TAG, "  Bit4 Zero point calibration not done: %s", ONOFF(alarm_event8 & 0x10));
-  ESP_LOGD(TAG, "  Bit5 Perpetual calendar not synchronized: %s", ONOFF(alarm_event8 & 0x20));
-  ESP_LOGD(TAG, "  Bit6 Internal: %s", ONOFF(alarm_event8 & 0x40));
-  ESP_LOGD(TAG, "  Bit7 Internal: %s", ONOFF(alarm_event8 & 0x80));
-  this->publish_state_(this->alarm_event8_bitmask_sensor_, (float) alarm_event8);
-
-  std::string consolidated_alarms = this->decode_all_alarm_events_(
-      alarm_event1, alarm_event2, alarm_event3, alarm_event4, alarm_event5, alarm_event6, alarm_event7, alarm_event8);
-  this->publish_state_(this->alarms_text_sensor_, consolidated_alarms);
+  // Alarm events 1-8: the bitmask sensors, the alarms text and the alarm triggers are updated on change only
+  uint8_t alarm_events[SEPLOS_ALARM_EVENT_COUNT];
+  std::memcpy(alarm_events, &data[alarm_offset], SEPLOS_ALARM_EVENT_COUNT);
+  ESP_LOGD(TAG, "Alarm events: %02X %02X %02X %02X %02X %02X %02X %02X", alarm_events[0], alarm_events[1],
+           alarm_events[2], alarm_events[3], alarm_events[4], alarm_events[5], alarm_events[6], alarm_events[7]);
+  this->update_alarm_events_(alarm_events);
 
   // Process additional custom alarm events if any (beyond the standard 8)
   if (custom_alarm_volume > 8) {
@@ -1174,7 +1185,7 @@ void SeplosBmsBle::decode_single_machine_data_(const std::vector<uint8_t> &data)
   }
 
   if (protection_offset + 24 < data.size()) {
-    ESP_LOGD(
+    ESP_LOGVV(
         TAG, "Remaining bytes: %s",
         format_hex_pretty(&data[protection_offset + 24], data.size() - protection_offset - 24 - 3).c_str());  // NOLINT
   }
@@ -1182,6 +1193,10 @@ void SeplosBmsBle::decode_single_machine_data_(const std::vector<uint8_t> &data)
 
 void SeplosBmsBle::dump_config() {  // NOLINT(google-readability-function-size,readability-function-size)
   ESP_LOGCONFIG(TAG, "SeplosBmsBle:");
+  ESP_LOGCONFIG(TAG, "  Response timeout: %d ms", this->response_timeout_);
+  ESP_LOGCONFIG(TAG, "  Max retries: %d", this->max_retries_);
+  ESP_LOGCONFIG(TAG, "  MTU: %u (local MTU of all BLE clients %u, negotiated %u)", this->requested_mtu_,
+                seplos_ble::get_local_mtu(), this->mtu_);
 
   LOG_BINARY_SENSOR("", "Charging", this->charging_binary_sensor_);
   LOG_BINARY_SENSOR("", "Discharging", this->discharging_binary_sensor_);
@@ -1251,6 +1266,9 @@ void SeplosBmsBle::dump_config() {  // NOLINT(google-readability-function-size,r
   LOG_SENSOR("", "Alarm Event 6 Bitmask", this->alarm_event6_bitmask_sensor_);
   LOG_SENSOR("", "Alarm Event 7 Bitmask", this->alarm_event7_bitmask_sensor_);
   LOG_SENSOR("", "Alarm Event 8 Bitmask", this->alarm_event8_bitmask_sensor_);
+  for (auto *setting_sensor : this->setting_sensors_) {
+    LOG_SENSOR("", "Setting", setting_sensor);
+  }
 
   LOG_TEXT_SENSOR("", "Device model", this->device_model_text_sensor_);
   LOG_TEXT_SENSOR("", "Hardware version", this->hardware_version_text_sensor_);
@@ -1305,7 +1323,7 @@ bool SeplosBmsBle::send_command(uint8_t function, const std::vector<uint8_t> &pa
   // Add payload if present
   data.insert(data.end(), payload.begin(), payload.end());
 
-  auto crc = crc_xmodem(data.data(), data.size());
+  auto crc = seplos_checksum::crc16_xmodem(data.data(), data.size());
   data.push_back(crc >> 8);
   data.push_back(crc >> 0);
 
@@ -1329,52 +1347,59 @@ bool SeplosBmsBle::send_command(uint8_t function, const std::vector<uint8_t> &pa
 bool SeplosBmsBle::send_command(uint8_t function, const std::vector<uint8_t> &payload) { return false; }
 #endif  // USE_ESP32
 
-std::string SeplosBmsBle::bitmask_to_string_(const char *const messages[], const uint8_t &messages_size,
-                                             const uint8_t &mask) {
-  std::string values;
-  if (mask) {
-    for (uint8_t i = 0; i < messages_size; i++) {
-      if (mask & (1 << i)) {
-        values.append(messages[i]);
-        values.append(";");
-      }
-    }
-    if (!values.empty()) {
-      values.pop_back();
-    }
+void SeplosBmsBle::update_alarm_events_(const uint8_t *alarm_events) {
+  if (this->alarm_events_valid_ &&
+      std::memcmp(alarm_events, this->alarm_events_, SEPLOS_ALARM_EVENT_COUNT) == 0) {
+    return;
   }
-  return values;
-}
 
-std::string SeplosBmsBle::decode_all_alarm_events_(uint8_t alarm_event1, uint8_t alarm_event2, uint8_t alarm_event3,
-                                                   uint8_t alarm_event4, uint8_t alarm_event5, uint8_t alarm_event6,
-                                                   uint8_t alarm_event7, uint8_t alarm_event8) {
-  std::string all_alarms;
+  sensor::Sensor *const bitmask_sensors[SEPLOS_ALARM_EVENT_COUNT] = {
+      this->alarm_event1_bitmask_sensor_, this->alarm_event2_bitmask_sensor_, this->alarm_event3_bitmask_sensor_,
+      this->alarm_event4_bitmask_sensor_, this->alarm_event5_bitmask_sensor_, this->alarm_event6_bitmask_sensor_,
+      this->alarm_event7_bitmask_sensor_, this->alarm_event8_bitmask_sensor_};
 
-  uint8_t alarm_events[8] = {alarm_event1, alarm_event2, alarm_event3, alarm_event4,
-                             alarm_event5, alarm_event6, alarm_event7, alarm_event8};
+  // Shared by all instances; status frames are decoded from the main loop only
+  static char text[ALARMS_TEXT_SIZE];
+  size_t length = 0;
 
-  const char *const *alarm_messages[8] = {ALARM_EVENT1_MESSAGES, ALARM_EVENT2_MESSAGES, ALARM_EVENT3_MESSAGES,
-                                          ALARM_EVENT4_MESSAGES, ALARM_EVENT5_MESSAGES, ALARM_EVENT6_MESSAGES,
-                                          ALARM_EVENT7_MESSAGES, ALARM_EVENT8_MESSAGES};
-
-  for (uint8_t event = 0; event < 8; event++) {
-    if (alarm_events[event]) {
-      std::string event_alarms = this->bitmask_to_string_(alarm_messages[event], 8, alarm_events[event]);
-      if (!event_alarms.empty()) {
-        if (!all_alarms.empty()) {
-          all_alarms.append(";");
+  for (uint8_t event = 0; event < SEPLOS_ALARM_EVENT_COUNT; event++) {
+    const uint8_t mask = alarm_events[event];
+    const uint8_t changed = mask ^ this->alarm_events_[event];
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      const char *message = ALARM_EVENT_MESSAGES[event][bit];
+      const bool active = (mask & (1 << bit)) != 0;
+
+      if (changed & (1 << bit)) {
+        if (active) {
+          ESP_LOGW(TAG, "Alarm set: %s", message);
+        } else {
+          ESP_LOGI(TAG, "Alarm cleared: %s", message);
         }
-        all_alarms.append(event_alarms);
+        this->alarm_callback_.call(event * 8 + bit, active, message);
+      }
+
+      if (active) {
+        if (length > 0)
+          text[length++] = ';';
+        const size_t message_length = std::strlen(message);
+        std::memcpy(text + length, message, message_length);
+        length += message_length;
       }
     }
+
+    this->publish_state_(bitmask_sensors[event], (float) mask);
   }
 
-  if (all_alarms.empty()) {
-    all_alarms = "No alarms";
+  if (this->alarms_text_sensor_ != nullptr) {
+    if (length == 0) {
+      this->publish_state_(this->alarms_text_sensor_, "No alarms");
+    } else {
+      this->publish_state_(this->alarms_text_sensor_, std::string(text, length));
+    }
   }
 
-  return all_alarms;
+  std::memcpy(this->alarm_events_, alarm_events, SEPLOS_ALARM_EVENT_COUNT);
+  this->alarm_events_valid_ = true;
 }
 
 }  // namespace esphome::seplos_bms_ble
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/components/switch/switch.h"
+#include "esphome/components/seplos_ble/byte_view.h"
+#include "esphome/components/seplos_ble/local_mtu.h"
 
 #ifdef USE_ESP32
 #include "esphome/components/ble_client/ble_client.h"
@@ -15,6 +21,41 @@ namespace espbt = esphome::esp32_ble_tracker;
 
 namespace esphome::seplos_bms_ble {
 
+// ATT MTU before the exchange and the notification payload overhead (opcode + handle)
+static const uint16_t BLE_DEFAULT_MTU = 23;
+static const uint8_t BLE_NOTIFY_OVERHEAD = 3;
+
+// Largest frame the assembler accepts
+static const uint16_t MAX_RESPONSE_SIZE = 200;
+
+using seplos_ble::ByteView;
+
+static const uint8_t SEPLOS_COMMAND_QUEUE_SIZE = 4;
+
+// Alarm event bitmasks of the status frame
+static const uint8_t SEPLOS_ALARM_EVENT_COUNT = 8;
+
+// Protection thresholds and parameters of the settings frame
+static const uint8_t SEPLOS_SETTINGS_COUNT = 66;
+static const uint8_t SEPLOS_FUNCTION_SWITCH_COUNT = 8;
+
+// Raw snapshot of the settings frame, compared against the next frame to publish changes only
+struct SeplosSettings {
+  uint16_t values[SEPLOS_SETTINGS_COUNT];
+  uint8_t function_switches[SEPLOS_FUNCTION_SWITCH_COUNT];
+};
+
+// Response statistics of a command of the poll cycle
+struct SeplosCommandStats {
+  uint32_t requests{0};
+  uint32_t responses{0};
+  uint32_t timeouts{0};
+  uint32_t skipped{0};
+  uint32_t last_latency{0};
+  uint32_t max_latency{0};
+  uint32_t total_latency{0};
+};
+
 class SeplosBmsBle :
 #ifdef USE_ESP32
     public esphome::ble_client::BLEClientNode,
@@ -25,7 +66,9 @@ class SeplosBmsBle :
   void gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                            esp_ble_gattc_cb_param_t *param) override;
 #endif
+  void setup() override;
   void dump_config() override;
+  void loop() override;
   void update() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
@@ -53,6 +96,11 @@ class SeplosBmsBle :
   void set_alarm_event8_bitmask_sensor(sensor::Sensor *sensor) { alarm_event8_bitmask_sensor_ = sensor; }
   void set_alarms_text_sensor(text_sensor::TextSensor *sensor) { alarms_text_sensor_ = sensor; }
 
+  // Called for every alarm bit which is set or cleared: alarm (event * 8 + bit), active, message
+  void add_on_alarm_callback(std::function<void(uint8_t, bool, const char *)> &&callback) {
+    this->alarm_callback_.add(std::move(callback));
+  }
+
   void set_total_voltage_sensor(sensor::Sensor *total_voltage_sensor) { total_voltage_sensor_ = total_voltage_sensor; }
   void set_current_sensor(sensor::Sensor *current_sensor) { current_sensor_ = current_sensor; }
   void set_power_sensor(sensor::Sensor *power_sensor) { power_sensor_ = power_sensor; }
@@ -125,6 +173,9 @@ class SeplosBmsBle :
   void set_temperature_sensor(uint8_t temperature, sensor::Sensor *temperature_sensor) {
     this->temperatures_[temperature].temperature_sensor_ = temperature_sensor;
   }
+  void set_setting_sensor(uint8_t setting, sensor::Sensor *setting_sensor) {
+    this->setting_sensors_[setting] = setting_sensor;
+  }
 
   void set_software_version_text_sensor(text_sensor::TextSensor *software_version_text_sensor) {
     software_version_text_sensor_ = software_version_text_sensor;
@@ -150,9 +201,18 @@ class SeplosBmsBle :
   void set_current_limit_switch(switch_::Switch *current_limit_switch) { current_limit_switch_ = current_limit_switch; }
   void set_heating_switch(switch_::Switch *heating_switch) { heating_switch_ = heating_switch; }
 
-  bool send_command(uint8_t function, const std::vector<uint8_t> &payload = {});
+  void set_response_timeout(uint16_t response_timeout) { response_timeout_ = response_timeout; }
+  void set_max_retries(uint8_t max_retries) { max_retries_ = max_retries; }
+  void set_mtu(uint16_t mtu) {
+    requested_mtu_ = mtu;
+    seplos_ble::request_local_mtu(mtu);
+  }
+  uint16_t get_mtu() const { return mtu_; }
+  const SeplosCommandStats &get_command_stats(uint8_t index) const { return command_stats_[index]; }
+
+  virtual bool send_command(uint8_t function, const std::vector<uint8_t> &payload = {});
   void assemble(const uint8_t *data, uint16_t length);
-  void decode(const std::vector<uint8_t> &data);
+  void decode(ByteView data);
   std::string interpret_can_protocol(uint8_t value);
   std::string interpret_rs485_protocol(uint8_t value);
   std::string interpret_battery_type(uint8_t value);
@@ -219,30 +279,83 @@ class SeplosBmsBle :
     sensor::Sensor *temperature_sensor_{nullptr};
   } temperatures_[8];
 
-  std::vector<uint8_t> frame_buffer_;
+  sensor::Sensor *setting_sensors_[SEPLOS_SETTINGS_COUNT]{};
+  SeplosSettings settings_{};
+  bool settings_valid_{false};
+
+  uint8_t alarm_events_[SEPLOS_ALARM_EVENT_COUNT]{};
+  bool alarm_events_valid_{false};
+  CallbackManager<void(uint8_t, bool, const char *)> alarm_callback_;
+
+  uint8_t frame_buffer_[MAX_RESPONSE_SIZE];
+  uint16_t frame_length_{0};
+  // CRC of the buffered frame, updated as the chunks arrive. crc_position_ is the next byte to hash
+  uint16_t frame_crc_{0};
+  uint16_t crc_position_{1};
+  uint16_t update_frame_crc_(size_t end);
   uint16_t char_notify_handle_{0};
   uint16_t char_command_handle_{0};
   uint8_t next_command_{0};
 
+  // Poll cycle: one command in flight, retried or skipped if the response is lost
+  uint16_t response_timeout_{500};
+  uint8_t max_retries_{1};
+
+  // Requested and negotiated ATT MTU of the connection
+  uint16_t requested_mtu_{247};
+  uint16_t mtu_{BLE_DEFAULT_MTU};
+  uint8_t retries_{0};
+  bool waiting_for_response_{false};
+  uint32_t last_send_{0};
+  uint32_t cycle_start_{0};
+  uint32_t poll_cycle_{0};
+  bool command_received_[SEPLOS_COMMAND_QUEUE_SIZE]{};
+  SeplosCommandStats command_stats_[SEPLOS_COMMAND_QUEUE_SIZE];
+
   float min_cell_voltage_{100.0f};
   float max_cell_voltage_{-100.0f};
   uint8_t max_voltage_cell_{0};
   uint8_t min_voltage_cell_{0};
 
-  void decode_manufacturer_info_data_(const std::vector<uint8_t> &data);
-  void decode_single_machine_data_(const std::vector<uint8_t> &data);
-  void decode_settings_data_(const std::vector<uint8_t> &data);
-  void decode_parallel_data_(const std::vector<uint8_t> &data);
+  void on_mtu_negotiated_(uint16_t mtu);
+  void start_poll_cycle_(uint32_t now);
+  bool command_due_(uint8_t index) const;
+  void send_next_due_command_(uint32_t now);
+  void send_queued_command_(uint32_t now);
+  void complete_command_(uint32_t now);
+  void check_command_timeout_(uint32_t now);
+  void advance_command_queue_(uint32_t now);
+  void decode_manufacturer_info_data_(ByteView data);
+  void decode_single_machine_data_(ByteView data);
+  void decode_settings_data_(ByteView data);
+  void decode_parallel_data_(ByteView data);
   void publish_state_(binary_sensor::BinarySensor *binary_sensor, const bool &state);
   void publish_state_(sensor::Sensor *sensor, float value);
   void publish_state_(text_sensor::TextSensor *text_sensor, const std::string &state);
   void publish_state_(switch_::Switch *obj, const bool &state);
-  std::string bitmask_to_string_(const char *const messages[], const uint8_t &messages_size, const uint8_t &mask);
-  std::string decode_all_alarm_events_(uint8_t alarm_event1, uint8_t alarm_event2, uint8_t alarm_event3,
-                                       uint8_t alarm_event4, uint8_t alarm_event5, uint8_t alarm_event6,
-                                       uint8_t alarm_event7, uint8_t alarm_event8);
+  void update_alarm_events_(const uint8_t *alarm_events);
 
   bool check_bit_(uint16_t mask, uint16_t flag) { return (mask & flag) == flag; }
 };
 
+class AlarmSetTrigger : public Trigger<uint8_t, const char *> {
+ public:
+  explicit AlarmSetTrigger(SeplosBmsBle *parent) {
+    parent->add_on_alarm_callback([this](uint8_t alarm, bool active, const char *message) {
+      if (active)
+        this->trigger(alarm, message);
+    });
+  }
+};
+
+class AlarmClearedTrigger : public Trigger<uint8_t, const char *> {
+ public:
+  explicit AlarmClearedTrigger(SeplosBmsBle *parent) {
+    parent->add_on_alarm_callback([this](uint8_t alarm, bool active, const char *message) {
+      if (!active)
+        this->trigger(alarm, message);
+    });
+  }
+};
+
 }  // namespace esphome::seplos_bms_ble
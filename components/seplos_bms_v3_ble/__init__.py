@@ -5,11 +5,16 @@ from esphome.const import CONF_ADDRESS, CONF_ID
 
 CODEOWNERS = ["@syssi"]
 DEPENDENCIES = ["ble_client"]
-AUTO_LOAD = ["binary_sensor", "sensor", "text_sensor"]
+AUTO_LOAD = ["seplos_ble", "seplos_checksum", "binary_sensor", "sensor", "text_sensor"]
 
 MULTI_CONF = True
 
 CONF_SEPLOS_BMS_V3_BLE_ID = "seplos_bms_v3_ble_id"
+CONF_RESPONSE_TIMEOUT = "response_timeout"
+CONF_MAX_RETRIES = "max_retries"
+CONF_MAX_REQUESTS_IN_FLIGHT = "max_requests_in_flight"
+CONF_MTU = "mtu"
+CONF_AUTO_DISCOVER_PACKS = "auto_discover_packs"
 
 seplos_bms_v3_ble_ns = cg.esphome_ns.namespace("seplos_bms_v3_ble")
 SeplosBmsV3Ble = seplos_bms_v3_ble_ns.class_(
@@ -28,6 +33,16 @@ CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(SeplosBmsV3Ble),
+            cv.Optional(
+                CONF_RESPONSE_TIMEOUT, default="500ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_MAX_RETRIES, default=1): cv.int_range(min=0, max=10),
+            cv.Optional(CONF_MAX_REQUESTS_IN_FLIGHT, default=1): cv.int_range(
+                min=1, max=3
+            ),
+            cv.Optional(CONF_MTU, default=247): cv.int_range(min=23, max=517),
+            # The discovered packs are assumed to use the addresses 1..N
+            cv.Optional(CONF_AUTO_DISCOVER_PACKS, default=False): cv.boolean,
         }
     )
     .extend(ble_client.BLE_CLIENT_SCHEMA)
@@ -54,3 +69,9 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await ble_client.register_ble_node(var, config)
+
+    cg.add(var.set_response_timeout(config[CONF_RESPONSE_TIMEOUT]))
+    cg.add(var.set_max_retries(config[CONF_MAX_RETRIES]))
+    cg.add(var.set_max_requests_in_flight(config[CONF_MAX_REQUESTS_IN_FLIGHT]))
+    cg.add(var.set_mtu(config[CONF_MTU]))
+    cg.add(var.set_auto_discover_packs(config[CONF_AUTO_DISCOVER_PACKS]))
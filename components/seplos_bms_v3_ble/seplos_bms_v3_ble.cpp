@@ -1,7 +1,13 @@
 #include "seplos_bms_v3_ble.h"
 #include "esphome/core/log.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/version.h"
+#include "esphome/components/seplos_checksum/seplos_checksum.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
 #include "../seplos_bms_v3_ble_pack/seplos_bms_v3_ble_pack.h"
 #include <cmath>
 
@@ -19,8 +25,6 @@ static const uint16_t SEPLOS_BMS_V3_SERVICE_UUID = 0xFFF0;
 static const uint16_t SEPLOS_BMS_V3_NOTIFY_CHARACTERISTIC_UUID = 0xFFF1;
 static const uint16_t SEPLOS_BMS_V3_CONTROL_CHARACTERISTIC_UUID = 0xFFF2;
 
-static const uint16_t MAX_RESPONSE_SIZE = 300;
-
 static const uint8_t SEPLOS_V3_CMD_READ_04 = 0x04;
 static const uint8_t SEPLOS_V3_CMD_READ_01 = 0x01;
 
@@ -48,23 +52,73 @@ static const uint16_t SEPLOS_V3_SPA_LENGTH = 0x35;
 // Factory(10) + Device(10) + FW(1) + BMS_SN(15) + Pack_SN(15) = 51 registers
 static const uint16_t SEPLOS_V3_VIA_LENGTH = 0x33;
 
+// Largest read of a Modbus request (125 registers, 250 bytes of data)
+static const uint16_t SEPLOS_V3_MAX_READ_REGISTERS = 0x7D;
+// Unused registers allowed between two merged blocks; the registers in between are not guaranteed to be
+// readable, so only adjacent blocks are merged
+static const uint16_t SEPLOS_V3_MAX_COALESCE_GAP = 0;
+
+// Refresh policy of a queued command: requested every n-th poll cycle
+static const uint16_t SEPLOS_V3_REFRESH_ONCE = 0;  // once per connection
+static const uint16_t SEPLOS_V3_REFRESH_ALWAYS = 1;
+static const uint16_t SEPLOS_V3_REFRESH_SETTINGS = 60;
+
+// System blocks; adjacent input register blocks are read at once if the negotiated MTU allows it (see
+// build_dynamic_command_queue_). The live blocks and the pack blocks are requested before the static ones
 static const SeplosV3Command SEPLOS_V3_SYSTEM_COMMANDS[] = {
-    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_EIA_START, SEPLOS_V3_EIA_LENGTH},
-    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_EIB_START, SEPLOS_V3_EIB_LENGTH},
-    {0x00, SEPLOS_V3_CMD_READ_01, SEPLOS_V3_REG_EIC_START, SEPLOS_V3_EIC_LENGTH},
-    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_VIA_START, SEPLOS_V3_VIA_LENGTH},
-    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_PCT_START, SEPLOS_V3_PCT_LENGTH},
-    {0x00, SEPLOS_V3_CMD_READ_01, SEPLOS_V3_REG_SFA_START, SEPLOS_V3_SFA_LENGTH},
-    {0xE0, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_SPA1_START, SEPLOS_V3_SPA_LENGTH},
-    {0xE0, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_SPA2_START, SEPLOS_V3_SPA_LENGTH},
+    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_EIA_START, SEPLOS_V3_EIA_LENGTH, SEPLOS_V3_REFRESH_ALWAYS},
+    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_EIB_START, SEPLOS_V3_EIB_LENGTH, SEPLOS_V3_REFRESH_ALWAYS},
+    {0x00, SEPLOS_V3_CMD_READ_01, SEPLOS_V3_REG_EIC_START, SEPLOS_V3_EIC_LENGTH, SEPLOS_V3_REFRESH_ALWAYS},
+    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_VIA_START, SEPLOS_V3_VIA_LENGTH, SEPLOS_V3_REFRESH_ONCE},
+    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_PCT_START, SEPLOS_V3_PCT_LENGTH, SEPLOS_V3_REFRESH_SETTINGS},
+    {0x00, SEPLOS_V3_CMD_READ_01, SEPLOS_V3_REG_SFA_START, SEPLOS_V3_SFA_LENGTH, SEPLOS_V3_REFRESH_SETTINGS},
+    {0xE0, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_SPA1_START, SEPLOS_V3_SPA_LENGTH, SEPLOS_V3_REFRESH_SETTINGS},
+    {0xE0, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_SPA2_START, SEPLOS_V3_SPA_LENGTH, SEPLOS_V3_REFRESH_SETTINGS},
 };
 
 static const SeplosV3Command SEPLOS_V3_PACK_COMMANDS[] = {
-    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_PIA_START, SEPLOS_V3_PIA_LENGTH},
-    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_PIB_START, SEPLOS_V3_PIB_LENGTH},
-    {0x00, SEPLOS_V3_CMD_READ_01, SEPLOS_V3_REG_PIC_START, SEPLOS_V3_PIC_LENGTH},
+    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_PIA_START, SEPLOS_V3_PIA_LENGTH, SEPLOS_V3_REFRESH_ALWAYS},
+    {0x00, SEPLOS_V3_CMD_READ_04, SEPLOS_V3_REG_PIB_START, SEPLOS_V3_PIB_LENGTH, SEPLOS_V3_REFRESH_ALWAYS},
+    {0x00, SEPLOS_V3_CMD_READ_01, SEPLOS_V3_REG_PIC_START, SEPLOS_V3_PIC_LENGTH, SEPLOS_V3_REFRESH_ALWAYS},
 };
 
+// Shortest Modbus-RTU response: device, function, byte count or error code and CRC
+static const uint8_t MODBUS_MIN_FRAME_SIZE = 5;
+
+// Header + data + CRC, exception responses carry no data
+static size_t modbus_frame_size(const uint8_t *frame) { return 3 + ((frame[1] & 0x80) == 0 ? frame[2] : 0) + 2; }
+
+// Device and function of a response the BMS could have sent
+static bool modbus_frame_start(const uint8_t *frame) {
+  const uint8_t device = frame[0];
+  const uint8_t function = frame[1] & 0x7F;
+  if (device != 0x00 && device != 0xE0 && (device < 1 || device > 16))
+    return false;
+  if (function != SEPLOS_V3_CMD_READ_01 && function != SEPLOS_V3_CMD_READ_04)
+    return false;
+  // Two bytes per register for normal responses, an error code for exception responses
+  return (frame[1] & 0x80) ? frame[2] != 0 : (frame[2] & 0x01) == 0;
+}
+
+// Hashed in one pass once the frame is complete: while resyncing every candidate start needs its own CRC, so the
+// CRC cannot run along with the arriving chunks
+static bool modbus_crc_valid(const uint8_t *frame, size_t size) {
+  const uint16_t frame_crc = frame[size - 2] | (frame[size - 1] << 8);
+  return seplos_checksum::crc16_modbus(frame, size - 2) == frame_crc;
+}
+
+// Offset of the first complete frame with a valid CRC at or after from, available if there is none
+static size_t find_modbus_frame(const uint8_t *raw, size_t from, size_t available) {
+  for (size_t pos = from; pos + MODBUS_MIN_FRAME_SIZE <= available; pos++) {
+    const uint8_t *frame = raw + pos;
+    if (modbus_frame_start(frame) && modbus_frame_size(frame) <= available - pos &&
+        modbus_crc_valid(frame, modbus_frame_size(frame))) {
+      return pos;
+    }
+  }
+  return available;
+}
+
 #ifdef USE_ESP32
 void SeplosBmsV3Ble::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                                          esp_ble_gattc_cb_param_t *param) {
@@ -75,12 +129,19 @@ void SeplosBmsV3Ble::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if
     case ESP_GATTC_DISCONNECT_EVT: {
       this->node_state = espbt::ClientState::IDLE;
       this->publish_state_(this->online_status_binary_sensor_, false);
-      this->frame_buffer_.clear();
+      this->frame_length_ = 0;
       this->next_command_ = 0;
+      this->request_count_ = 0;
+      this->expired_count_ = 0;
+      this->polling_ = false;
+      this->poll_cycle_ = 0;
+      std::fill(this->command_received_.begin(), this->command_received_.end(), false);
+      this->mtu_ = BLE_DEFAULT_MTU;
       this->pack_count_ = 0;
       break;
     }
     case ESP_GATTC_SEARCH_CMPL_EVT: {
+      // Not cached: the service discovery of the ble_client cannot be skipped, it has to finish first
       auto *char_notify =
           this->parent_->get_characteristic(SEPLOS_BMS_V3_SERVICE_UUID, SEPLOS_BMS_V3_NOTIFY_CHARACTERISTIC_UUID);
       if (char_notify == nullptr) {
@@ -106,20 +167,26 @@ void SeplosBmsV3Ble::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if
       this->char_command_handle_ = char_command->handle;
       break;
     }
+    case ESP_GATTC_CFG_MTU_EVT: {
+      // The MTU exchange is started by the BLE client after connecting, using the local MTU set in setup()
+      if (param->cfg_mtu.status == ESP_GATT_OK) {
+        this->on_mtu_negotiated_(param->cfg_mtu.mtu);
+      }
+      break;
+    }
     case ESP_GATTC_REG_FOR_NOTIFY_EVT: {
       this->node_state = espbt::ClientState::ESTABLISHED;
       this->publish_state_(this->online_status_binary_sensor_, true);
 
-      if (!this->dynamic_command_queue_.empty()) {
-        this->pending_reg_start_ = this->dynamic_command_queue_[0].reg_start;
-        this->send_command_(this->dynamic_command_queue_[0].function,
-                            this->build_modbus_payload_(this->dynamic_command_queue_[0]));
-      }
+      this->build_dynamic_command_queue_();
+      this->start_poll_cycle_(millis());
       break;
     }
     case ESP_GATTC_NOTIFY_EVT: {
       ESP_LOGVV(TAG, "Notification received: %s",
                 format_hex_pretty(param->notify.value, param->notify.value_len).c_str());  // NOLINT
+      // Already on the main loop task: esp32_ble queues the GATTC events of the Bluetooth stack and hands them
+      // to the clients from its loop(), so the frame is assembled and decoded right here
       this->assemble(param->notify.value, param->notify.value_len);
       break;
     }
@@ -133,6 +200,12 @@ void SeplosBmsV3Ble::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if
 void SeplosBmsV3Ble::dump_config() {
   ESP_LOGCONFIG(TAG, "Seplos BMS V3 BLE");
   ESP_LOGCONFIG(TAG, "  Update interval: %dms", this->get_update_interval());
+  ESP_LOGCONFIG(TAG, "  Response timeout: %d ms", this->response_timeout_);
+  ESP_LOGCONFIG(TAG, "  Max retries: %d", this->max_retries_);
+  ESP_LOGCONFIG(TAG, "  Max requests in flight: %d", this->max_requests_in_flight_);
+  ESP_LOGCONFIG(TAG, "  Auto discover packs: %s", YESNO(this->auto_discover_packs_));
+  ESP_LOGCONFIG(TAG, "  MTU: %u (local MTU of all BLE clients %u, negotiated %u)", this->requested_mtu_,
+                seplos_ble::get_local_mtu(), this->mtu_);
 }
 
 #ifdef USE_ESP32
@@ -144,127 +217,393 @@ void SeplosBmsV3Ble::update() {
 
   // Build command queue once when first update is called (all pack devices are registered by then)
   this->build_dynamic_command_queue_();
+  this->start_poll_cycle_(millis());
+}
 
-  if (this->next_command_ != 0) {
-    ESP_LOGW(TAG, "Command queue (%d of %d) was not completely processed", this->next_command_,
-             this->dynamic_command_queue_.size());
+void SeplosBmsV3Ble::setup() {
+  // Global for all BLE clients of the node: the largest MTU of all instances is applied once
+  seplos_ble::apply_local_mtu();
+}
+#else
+void SeplosBmsV3Ble::update() {}
+void SeplosBmsV3Ble::setup() {}
+#endif  // USE_ESP32
+
+void SeplosBmsV3Ble::on_mtu_negotiated_(uint16_t mtu) {
+  this->mtu_ = mtu;
+  const uint16_t payload = mtu - BLE_NOTIFY_OVERHEAD;
+  ESP_LOGI(TAG, "MTU %u negotiated (requested %u): %u bytes per notification, up to %u notifications per frame", mtu,
+           seplos_ble::get_local_mtu(), payload, (MAX_RESPONSE_SIZE + payload - 1) / payload);
+}
+
+void SeplosBmsV3Ble::loop() { this->check_command_timeout_(millis()); }
+
+void SeplosBmsV3Ble::start_poll_cycle_(uint32_t now) {
+  if (this->polling_) {
+    ESP_LOGW(TAG, "Command queue (%d of %zu, %d pending) was not completely processed", this->next_command_,
+             this->dynamic_command_queue_.size(), this->request_count_);
+    this->poll_cycle_++;
+  }
+
+  // Requests of an unfinished cycle may still be answered
+  for (uint8_t i = 0; i < this->request_count_; i++) {
+    this->expire_request_(this->requests_[i], now);
   }
 
   this->next_command_ = 0;
+  this->request_count_ = 0;
+  this->polling_ = false;
+  this->cycle_start_ = now;
   if (!this->dynamic_command_queue_.empty()) {
-    this->pending_reg_start_ = this->dynamic_command_queue_[0].reg_start;
-    this->send_command_(this->dynamic_command_queue_[0].function,
-                        this->build_modbus_payload_(this->dynamic_command_queue_[0]));
-    this->next_command_++;
+    this->polling_ = true;
+    this->fill_pipeline_(now);
   }
 }
-#else
-void SeplosBmsV3Ble::update() {}
-#endif  // USE_ESP32
 
-void SeplosBmsV3Ble::assemble(const uint8_t *data, uint16_t length) {
-  if (this->frame_buffer_.size() > MAX_RESPONSE_SIZE) {
-    ESP_LOGW(TAG, "Frame dropped because of invalid length");
-    this->frame_buffer_.clear();
+void SeplosBmsV3Ble::fill_pipeline_(uint32_t now) {
+  if (!this->polling_)
+    return;
+
+  while (this->request_count_ < this->max_requests_in_flight_ &&
+         this->next_command_ < this->dynamic_command_queue_.size()) {
+    const uint8_t command = this->next_command_;
+    if (this->command_due_(command)) {
+      // Responses are matched by device, function and size only: EIA and EIB of the system look alike, so a
+      // command waits until no response of the same size can arrive anymore
+      const SeplosV3Command &cmd = this->dynamic_command_queue_[command];
+      if (this->response_pending_(cmd.device, cmd.function, (uint8_t) (cmd.reg_count * 2)))
+        break;
+      this->send_request_(command, 0, now);
+    }
+    this->next_command_++;
   }
 
-  // Add incoming data to buffer
-  this->frame_buffer_.insert(this->frame_buffer_.end(), data, data + length);
+  if (this->request_count_ > 0 || this->next_command_ < this->dynamic_command_queue_.size())
+    return;
 
-  // Check if we have a complete ModBus frame
-  if (this->frame_buffer_.size() >= 5) {
-    uint8_t function = this->frame_buffer_[1];
-    uint16_t data_len = 0;
+  this->polling_ = false;
+  ESP_LOGD(TAG, "Poll cycle %" PRIu32 " completed in %" PRIu32 " ms", this->poll_cycle_, now - this->cycle_start_);
+  for (size_t i = 0; i < this->dynamic_command_queue_.size(); i++) {
+    const SeplosV3CommandStats &stats = this->command_stats_[i];
+    ESP_LOGV(TAG,
+             "  Device 0x%02X register 0x%04X: %" PRIu32 " requests, %" PRIu32 " responses, %" PRIu32
+             " timeouts, %" PRIu32 " skipped, latency %" PRIu32 " ms (avg %" PRIu32 " ms, max %" PRIu32 " ms)",
+             this->dynamic_command_queue_[i].device, this->dynamic_command_queue_[i].reg_start, stats.requests,
+             stats.responses, stats.timeouts, stats.skipped, stats.last_latency,
+             stats.responses ? stats.total_latency / stats.responses : 0, stats.max_latency);
+  }
+  this->poll_cycle_++;
+}
 
-    if ((function & 0x80) == 0) {
-      data_len = this->frame_buffer_[2];
-    }
+bool SeplosBmsV3Ble::command_due_(uint8_t command) const {
+  const uint16_t refresh_cycles = this->dynamic_command_queue_[command].refresh_cycles;
 
-    uint16_t expected_length = 3 + data_len + 2;  // header + data + CRC
+  // Everything is requested until it was answered once on this connection
+  if (!this->command_received_[command])
+    return true;
 
-    if (this->frame_buffer_.size() >= expected_length) {
-      // Verify CRC
-      uint16_t frame_crc = this->frame_buffer_[expected_length - 2] | (this->frame_buffer_[expected_length - 1] << 8);
-      uint16_t computed_crc = this->crc16_(this->frame_buffer_.data(), expected_length - 2);
+  if (refresh_cycles == SEPLOS_V3_REFRESH_ONCE)
+    return false;
 
-      if (computed_crc == frame_crc) {
-        std::vector<uint8_t> complete_frame(this->frame_buffer_.begin(), this->frame_buffer_.begin() + expected_length);
-        this->decode(complete_frame);
+  return this->poll_cycle_ % refresh_cycles == 0;
+}
 
+void SeplosBmsV3Ble::send_request_(uint8_t command, uint8_t retries, uint32_t now) {
+  const SeplosV3Command &cmd = this->dynamic_command_queue_[command];
+
+  this->command_stats_[command].requests++;
+
+  SeplosV3Request &request = this->requests_[this->request_count_++];
+  request.command = command;
+  request.device = cmd.device;
+  request.function = cmd.function;
+  // Both read functions answer with two bytes per register; the byte count field is 8 bits wide
+  request.byte_count = (uint8_t) (cmd.reg_count * 2);
+  request.reg_start = cmd.reg_start;
+  request.reg_count = cmd.reg_count;
+  request.retries = retries;
+  request.sent_at = now;
 #ifdef USE_ESP32
-        // Send next command if available
-        if (this->next_command_ < this->dynamic_command_queue_.size()) {
-          this->pending_reg_start_ = this->dynamic_command_queue_[this->next_command_].reg_start;
-          this->send_command_(this->dynamic_command_queue_[this->next_command_].function,
-                              this->build_modbus_payload_(this->dynamic_command_queue_[this->next_command_]));
-          this->next_command_++;
-        }
+  this->send_command_(cmd.function, this->build_modbus_payload_(cmd));
 #endif
-      } else {
-        ESP_LOGW(TAG, "CRC check failed! 0x%04X != 0x%04X", computed_crc, frame_crc);
-      }
+}
+
+static int find_request(const SeplosV3Request *requests, uint8_t count, uint8_t device, uint8_t function,
+                        uint8_t byte_count) {
+  // The BMS answers in order: the oldest request of the device with the same function and response size matches.
+  // Exception responses carry an error code instead of the byte count
+  const bool exception = function & 0x80;
+  for (uint8_t i = 0; i < count; i++) {
+    const SeplosV3Request &candidate = requests[i];
+    if (candidate.device != device || candidate.function != (function & 0x7F))
+      continue;
+    if (!exception && candidate.byte_count != byte_count)
+      continue;
+    return i;
+  }
+  return -1;
+}
+
+static void remove_request(SeplosV3Request *requests, uint8_t *count, uint8_t index) {
+  for (uint8_t i = index + 1; i < *count; i++) {
+    requests[i - 1] = requests[i];
+  }
+  (*count)--;
+}
+
+bool SeplosBmsV3Ble::take_request_(uint8_t device, uint8_t function, uint8_t byte_count, SeplosV3Request *request) {
+  const int index = find_request(this->requests_, this->request_count_, device, function, byte_count);
+  if (index < 0)
+    return false;
+
+  *request = this->requests_[index];
+  this->remove_request_(index);
+  return true;
+}
+
+bool SeplosBmsV3Ble::take_expired_request_(uint8_t device, uint8_t function, uint8_t byte_count,
+                                           SeplosV3Request *request) {
+  const int index = find_request(this->expired_requests_, this->expired_count_, device, function, byte_count);
+  if (index < 0)
+    return false;
 
-      this->frame_buffer_.clear();
+  *request = this->expired_requests_[index];
+  remove_request(this->expired_requests_, &this->expired_count_, index);
+  return true;
+}
+
+bool SeplosBmsV3Ble::response_pending_(uint8_t device, uint8_t function, uint8_t byte_count) const {
+  return find_request(this->requests_, this->request_count_, device, function, byte_count) >= 0 ||
+         find_request(this->expired_requests_, this->expired_count_, device, function, byte_count) >= 0;
+}
+
+void SeplosBmsV3Ble::remove_request_(uint8_t index) { remove_request(this->requests_, &this->request_count_, index); }
+
+void SeplosBmsV3Ble::expire_request_(const SeplosV3Request &request, uint32_t now) {
+  if (this->expired_count_ == MAX_EXPIRED_REQUESTS) {
+    remove_request(this->expired_requests_, &this->expired_count_, 0);
+  }
+
+  SeplosV3Request &expired = this->expired_requests_[this->expired_count_++];
+  expired = request;
+  expired.sent_at = now;
+}
+
+void SeplosBmsV3Ble::complete_request_(const SeplosV3Request &request, uint32_t now) {
+  SeplosV3CommandStats &stats = this->command_stats_[request.command];
+  const uint32_t latency = now - request.sent_at;
+
+  stats.responses++;
+  stats.last_latency = latency;
+  stats.max_latency = std::max(stats.max_latency, latency);
+  stats.total_latency += latency;
+
+  this->command_received_[request.command] = true;
+  this->fill_pipeline_(now);
+}
+
+void SeplosBmsV3Ble::check_command_timeout_(uint32_t now) {
+  bool expired = false;
+
+  // A timed out request is not expected to be answered after another response timeout
+  while (this->expired_count_ > 0 && now - this->expired_requests_[0].sent_at >= this->response_timeout_) {
+    remove_request(this->expired_requests_, &this->expired_count_, 0);
+    expired = true;
+  }
+
+  // Requests are kept in the order they were sent, so the oldest one times out first
+  while (this->request_count_ > 0 && now - this->requests_[0].sent_at >= this->response_timeout_) {
+    const SeplosV3Request request = this->requests_[0];
+    this->remove_request_(0);
+    expired = true;
+
+    SeplosV3CommandStats &stats = this->command_stats_[request.command];
+    stats.timeouts++;
+    this->expire_request_(request, now);
+
+    if (request.retries < this->max_retries_) {
+      ESP_LOGD(TAG, "No response from device 0x%02X (register 0x%04X) within %d ms. Retry %d of %d", request.device,
+               request.reg_start, this->response_timeout_, request.retries + 1, this->max_retries_);
+      this->send_request_(request.command, request.retries + 1, now);
+      continue;
     }
+
+    ESP_LOGW(TAG, "No response from device 0x%02X (register 0x%04X) after %d attempts. Skipping it", request.device,
+             request.reg_start, request.retries + 1);
+    stats.skipped++;
+  }
+
+  if (expired) {
+    this->fill_pipeline_(now);
   }
 }
 
-void SeplosBmsV3Ble::decode(const std::vector<uint8_t> &data) {
+void SeplosBmsV3Ble::assemble(const uint8_t *data, uint16_t length) {
+  if (this->frame_length_ == 0) {
+    // With a large MTU whole frames arrive in one notification: they are decoded without a copy and only an
+    // incomplete remainder is buffered
+    const size_t consumed = this->consume_frames_(data, length);
+    this->frame_length_ = length - consumed;
+    memcpy(this->frame_buffer_, data + consumed, this->frame_length_);
+    return;
+  }
+
+  while (length > 0) {
+    // The remainder of a consumed buffer is shorter than the largest frame, so every round makes room
+    const uint16_t chunk = std::min<uint16_t>(length, MAX_RESPONSE_SIZE - this->frame_length_);
+    memcpy(this->frame_buffer_ + this->frame_length_, data, chunk);
+    this->frame_length_ += chunk;
+    data += chunk;
+    length -= chunk;
+
+    const size_t consumed = this->consume_frames_(this->frame_buffer_, this->frame_length_);
+    this->frame_length_ -= consumed;
+    memmove(this->frame_buffer_, this->frame_buffer_ + consumed, this->frame_length_);
+  }
+}
+
+size_t SeplosBmsV3Ble::consume_frames_(const uint8_t *raw, size_t available) {
+  size_t pos = 0;
+  size_t dropped = 0;
+
+  while (available - pos >= MODBUS_MIN_FRAME_SIZE) {
+    const uint8_t *frame = raw + pos;
+    if (!modbus_frame_start(frame)) {
+      pos++;
+      dropped++;
+      continue;
+    }
+
+    const size_t size = modbus_frame_size(frame);
+    if (available - pos < size) {
+      // The length of a corrupted header is not trusted: a complete frame further on wins
+      const size_t next = find_modbus_frame(raw, pos + 1, available);
+      if (next == available)
+        break;
+      dropped += next - pos;
+      pos = next;
+      continue;
+    }
+
+    if (!modbus_crc_valid(frame, size)) {
+      // Resync on the next byte, the bytes of a following frame are kept
+      if (dropped == 0) {
+        ESP_LOGW(TAG, "CRC check failed for a frame of device 0x%02X (%zu bytes)", frame[0], size);
+      }
+      pos++;
+      dropped++;
+      continue;
+    }
+
+    // The frame is decoded in place; the buffer is reused once decode() returns
+    this->decode(ByteView(frame, size));
+    pos += size;
+  }
+
+  if (dropped > 0) {
+    ESP_LOGW(TAG, "%zu bytes dropped to resynchronize", dropped);
+  }
+  return pos;
+}
+
+void SeplosBmsV3Ble::decode(ByteView data) {
   uint8_t device = data[0];
   uint8_t function = data[1];
   uint16_t data_len = data[2];
 
   ESP_LOGD(TAG, "Decoding frame: device=0x%02X, function=0x%02X, length=%d", device, function, data_len);
 
+  SeplosV3Request request;
+  const bool requested = this->take_request_(device, function, data_len, &request);
+  // A request which timed out may still be answered, the response has the layout of that request
+  const bool late = !requested && this->take_expired_request_(device, function, data_len, &request);
+  if (late) {
+    ESP_LOGD(TAG, "Late response from device 0x%02X (register 0x%04X)", device, request.reg_start);
+  }
+
   if (function & 0x80) {
     ESP_LOGW(TAG, "Error response from device 0x%02X, error code: 0x%02X", device, data[2]);
-    return;
+  } else if (device == 0x00 || device == 0xE0) {
+    // The system blocks are told apart by the register start of the request only
+    if (!requested && !late) {
+      ESP_LOGW(TAG, "Unexpected response from device 0x%02X (%d bytes) dropped", device, data_len);
+      return;
+    }
+
+    this->decode_system_blocks_(request, data.subview(3, data.size() - 5));
+  } else if (device >= 1 && device <= 16) {
+    auto it = std::find_if(this->pack_devices_.begin(), this->pack_devices_.end(),
+                           [device](SeplosBmsV3BlePack *pack_device) { return pack_device->get_address() == device; });
+    if (it != this->pack_devices_.end()) {
+      (*it)->on_frame_data(data);
+    } else if (this->auto_discover_packs_) {
+      ESP_LOGV(TAG, "No pack sensor for discovered address 0x%02X, response counted in the statistics only", device);
+    } else {
+      ESP_LOGW(TAG, "No pack sensor found for address: 0x%02X", device);
+    }
   }
 
-  std::vector<uint8_t> payload(data.begin() + 3, data.end() - 2);
+  // Send the next command once a pending one is answered
+  if (requested) {
+    this->complete_request_(request, millis());
+  } else if (late) {
+    this->fill_pipeline_(millis());
+  }
+}
 
-  if (device == 0x00 || device == 0xE0) {
-    switch (this->pending_reg_start_) {
-      case SEPLOS_V3_REG_EIA_START:
-        this->decode_eia_data_(payload);
-        break;
-      case SEPLOS_V3_REG_EIB_START:
-        this->decode_eib_data_(payload);
-        break;
-      case SEPLOS_V3_REG_EIC_START:
-        this->decode_eic_data_(payload);
-        break;
-      case SEPLOS_V3_REG_VIA_START:
-        this->decode_via_data_(payload);
-        break;
-      case SEPLOS_V3_REG_PCT_START:
-        this->decode_pct_data_(payload);
-        break;
-      case SEPLOS_V3_REG_SFA_START:
-        this->decode_sfa_data_(payload);
-        break;
-      case SEPLOS_V3_REG_SPA1_START:
-        this->decode_spa1_data_(payload);
-        break;
-      case SEPLOS_V3_REG_SPA2_START:
-        this->decode_spa2_data_(payload);
-        break;
-      default:
-        ESP_LOGW(TAG, "Unknown pending register start: 0x%04X (data_len=%d)", this->pending_reg_start_, data_len);
-        break;
+void SeplosBmsV3Ble::decode_system_blocks_(const SeplosV3Request &request, ByteView payload) {
+  // A merged response is split into the blocks it covers
+  for (const auto &block : SEPLOS_V3_SYSTEM_COMMANDS) {
+    if (block.device != request.device || block.function != request.function ||
+        block.reg_start < request.reg_start ||
+        block.reg_start + block.reg_count > request.reg_start + request.reg_count) {
+      continue;
     }
-  } else if (device >= 1 && device <= 16) {
-    for (auto *pack_device : this->pack_devices_) {
-      if (pack_device->get_address() == device) {
-        pack_device->on_frame_data(data);
-        return;
-      }
+
+    const size_t offset = (size_t) (block.reg_start - request.reg_start) * 2;
+    const size_t length = (size_t) block.reg_count * 2;
+    if (offset + length > payload.size()) {
+      ESP_LOGW(TAG, "Response of device 0x%02X too short for register 0x%04X: %zu bytes", request.device,
+               block.reg_start, payload.size());
+      continue;
     }
-    ESP_LOGW(TAG, "No pack sensor found for address: 0x%02X", device);
+    this->decode_system_block_(block.reg_start, payload.subview(offset, length));
   }
 }
 
-void SeplosBmsV3Ble::decode_eia_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3Ble::decode_system_block_(uint16_t reg_start, ByteView data) {
+  switch (reg_start) {
+    case SEPLOS_V3_REG_EIA_START:
+      this->decode_eia_data_(data);
+      break;
+    case SEPLOS_V3_REG_EIB_START:
+      this->decode_eib_data_(data);
+      break;
+    case SEPLOS_V3_REG_EIC_START:
+      this->decode_eic_data_(data);
+      break;
+    case SEPLOS_V3_REG_VIA_START:
+      this->decode_via_data_(data);
+      break;
+    case SEPLOS_V3_REG_PCT_START:
+      this->decode_pct_data_(data);
+      break;
+    case SEPLOS_V3_REG_SFA_START:
+      this->decode_sfa_data_(data);
+      break;
+    case SEPLOS_V3_REG_SPA1_START:
+      this->decode_spa1_data_(data);
+      break;
+    case SEPLOS_V3_REG_SPA2_START:
+      this->decode_spa2_data_(data);
+      break;
+    default:
+      ESP_LOGW(TAG, "Unknown register start: 0x%04X (%zu bytes)", reg_start, data.size());
+      break;
+  }
+}
+
+void SeplosBmsV3Ble::decode_eia_data_(ByteView data) {
   auto seplos_get_16bit = [&](size_t i) -> uint16_t {
     return (uint16_t(data[i + 0]) << 8) | (uint16_t(data[i + 1]) << 0);
   };
@@ -318,8 +657,12 @@ void SeplosBmsV3Ble::decode_eia_data_(const std::vector<uint8_t> &data) {
   this->publish_state_(this->max_charge_current_sensor_, seplos_get_32bit(36) * 0.1f);
 
   // Pack count (Reg 0x2016)
-  uint16_t pack_count = seplos_get_16bit(44);
-  this->pack_count_ = std::min(pack_count, (uint16_t) 16);
+  uint16_t pack_count = std::min(seplos_get_16bit(44), (uint16_t) 16);
+  if (this->auto_discover_packs_ && pack_count != this->pack_count_) {
+    ESP_LOGI(TAG, "Pack count changed from %d to %d, the packs are polled from the next cycle on", this->pack_count_,
+             pack_count);
+  }
+  this->pack_count_ = pack_count;
   this->publish_state_(this->pack_count_sensor_, (float) this->pack_count_);
 
   // Cycles (Reg 0x2017)
@@ -341,21 +684,15 @@ void SeplosBmsV3Ble::decode_eia_data_(const std::vector<uint8_t> &data) {
   }
 }
 
-void SeplosBmsV3Ble::decode_eib_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3Ble::decode_eib_data_(ByteView data) {
   auto seplos_get_16bit = [&](size_t i) -> uint16_t {
     return (uint16_t(data[i + 0]) << 8) | (uint16_t(data[i + 1]) << 0);
   };
 
   ESP_LOGD(TAG, "Decoding EIB data (%zu bytes)", data.size());
 
-  // Debug: Print raw hex data
-  std::string hex_str;
-  for (size_t i = 0; i < std::min((size_t) 32, data.size()); i++) {
-    char hex[4];
-    sprintf(hex, "%02X ", data[i]);  // NOLINT
-    hex_str += hex;
-  }
-  ESP_LOGD(TAG, "EIB raw data (first 32 bytes): %s", hex_str.c_str());
+  ESP_LOGVV(TAG, "EIB raw data (first 32 bytes): %s",
+            format_hex_pretty(data.data(), std::min((size_t) 32, data.size())).c_str());  // NOLINT
 
   // Max Cell Voltage - EIB register 0x2100
   uint16_t max_cell_voltage = seplos_get_16bit(0);
@@ -434,7 +771,7 @@ void SeplosBmsV3Ble::decode_eib_data_(const std::vector<uint8_t> &data) {
   this->publish_state_(this->delta_voltage_sensor_, delta_voltage);
 }
 
-void SeplosBmsV3Ble::decode_eic_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3Ble::decode_eic_data_(ByteView data) {
   ESP_LOGD(TAG, "Decoding EIC data (%zu bytes)", data.size());
 
   if (data.size() < 10) {
@@ -457,7 +794,12 @@ void SeplosBmsV3Ble::decode_eic_data_(const std::vector<uint8_t> &data) {
   problem_code |= uint32_t(data[9] != 0) << 6;           // TB15 hard fault
 
   this->publish_state_(this->problem_code_sensor_, (float) problem_code);
-  this->publish_state_(this->problem_text_sensor_, problem_code != 0 ? "Problem detected" : "No problems");
+  // Published on change only: the text would be copied into a temporary std::string on every frame
+  const char *problem_text = problem_code != 0 ? "Problem detected" : "No problems";
+  if (this->problem_text_sensor_ != nullptr &&
+      (!this->problem_text_sensor_->has_state() || this->problem_text_sensor_->state != problem_text)) {
+    this->problem_text_sensor_->publish_state(problem_text);
+  }
 
   // Raw event-code registers (diagnostic). The temperature code merges the cell
   // (TB03, data[2]) and ambient/power (TB04, data[3]) event bytes into one 16-bit
@@ -478,7 +820,7 @@ void SeplosBmsV3Ble::decode_eic_data_(const std::vector<uint8_t> &data) {
   this->publish_state_(this->heating_binary_sensor_, (data[3] & 0x40) != 0);
 }
 
-void SeplosBmsV3Ble::decode_via_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3Ble::decode_via_data_(ByteView data) {
   ESP_LOGD(TAG, "Decoding VIA data (Version Info) - %zu bytes", data.size());
 
   if (data.size() < 102) {
@@ -525,7 +867,7 @@ void SeplosBmsV3Ble::decode_via_data_(const std::vector<uint8_t> &data) {
   this->publish_state_(this->pack_serial_number_text_sensor_, pack_serial);
 }
 
-void SeplosBmsV3Ble::decode_pct_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3Ble::decode_pct_data_(ByteView data) {
   // PCT (inverter protocol settings, registers 6144–6179, see "XZH BMS Modbus-RTU Protocol").
   // The payload is the register block itself (big-endian UINT16, no length prefix).
   ESP_LOGD(TAG, "Decoding PCT data (Protocol Control Type) - %zu bytes", data.size());
@@ -560,7 +902,7 @@ void SeplosBmsV3Ble::decode_pct_data_(const std::vector<uint8_t> &data) {
   this->publish_state_(this->inverter_protocol_pre_switch_sensor_, (float) reg(0x1823));
 }
 
-void SeplosBmsV3Ble::decode_sfa_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3Ble::decode_sfa_data_(ByteView data) {
   ESP_LOGD(TAG, "Decoding SFA data (System Function Switches) - %zu bytes", data.size());
 
   if (data.size() < 20) {
@@ -584,7 +926,7 @@ void SeplosBmsV3Ble::decode_sfa_data_(const std::vector<uint8_t> &data) {
 // is fetched in two requests (0x1300 and 0x1335), each a full SEPLOS_V3_SPA_LENGTH
 // register block. Values are plain big-endian UINT16.
 
-void SeplosBmsV3Ble::decode_spa1_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3Ble::decode_spa1_data_(ByteView data) {
   ESP_LOGD(TAG, "Decoding SPA data (System Parameters, 0x1300) - %zu bytes", data.size());
 
   if (data.size() < SEPLOS_V3_SPA_LENGTH * 2) {
@@ -632,7 +974,7 @@ void SeplosBmsV3Ble::decode_spa1_data_(const std::vector<uint8_t> &data) {
   this->publish_state_(this->charge_low_temperature_alarm_sensor_, temperature(0x1334));
 }
 
-void SeplosBmsV3Ble::decode_spa2_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3Ble::decode_spa2_data_(ByteView data) {
   ESP_LOGD(TAG, "Decoding SPA data (System Parameters, 0x1335) - %zu bytes", data.size());
 
   if (data.size() < SEPLOS_V3_SPA_LENGTH * 2) {
@@ -701,28 +1043,13 @@ std::vector<uint8_t> SeplosBmsV3Ble::build_modbus_payload_(const SeplosV3Command
   payload.push_back((count >> 8) & 0xFF);
   payload.push_back(count & 0xFF);
 
-  uint16_t crc = this->crc16_(payload.data(), payload.size());
+  uint16_t crc = seplos_checksum::crc16_modbus(payload.data(), payload.size());
   payload.push_back(crc & 0xFF);
   payload.push_back((crc >> 8) & 0xFF);
 
   return payload;
 }
 
-uint16_t SeplosBmsV3Ble::crc16_(const uint8_t *data, uint16_t length) {
-  uint16_t crc = 0xFFFF;
-  for (uint16_t i = 0; i < length; i++) {
-    crc ^= data[i];
-    for (uint8_t j = 0; j < 8; j++) {
-      if (crc & 0x0001) {
-        crc = (crc >> 1) ^ 0xA001;
-      } else {
-        crc = crc >> 1;
-      }
-    }
-  }
-  return crc;
-}
-
 void SeplosBmsV3Ble::publish_state_(binary_sensor::BinarySensor *binary_sensor, const bool &state) {
   if (binary_sensor != nullptr) {
     binary_sensor->publish_state(state);
@@ -742,32 +1069,105 @@ void SeplosBmsV3Ble::publish_state_(text_sensor::TextSensor *text_sensor, const
 }
 
 void SeplosBmsV3Ble::build_dynamic_command_queue_() {
-  if (!this->dynamic_command_queue_.empty()) {
+  if (!this->dynamic_command_queue_.empty() && this->queue_mtu_ == this->mtu_ &&
+      (!this->auto_discover_packs_ || this->queue_pack_count_ == this->pack_count_)) {
     ESP_LOGD(TAG, "Command queue already built with %zu commands, skipping rebuild",
              this->dynamic_command_queue_.size());
     return;
   }
 
-  // Add system commands (always present)
-  for (const auto &cmd : SEPLOS_V3_SYSTEM_COMMANDS) {
-    this->dynamic_command_queue_.push_back(cmd);
-  }
+  // Rebuilt once the MTU is negotiated (a larger MTU allows to merge more blocks) and whenever the number of
+  // discovered packs changes
+  const std::vector<SeplosV3Command> previous_queue = std::move(this->dynamic_command_queue_);
+  this->dynamic_command_queue_.clear();
+  this->queue_mtu_ = this->mtu_;
+  this->queue_pack_count_ = this->pack_count_;
+
+  auto add_system_commands = [this](bool live) {
+    for (const auto &cmd : SEPLOS_V3_SYSTEM_COMMANDS) {
+      if ((cmd.refresh_cycles == SEPLOS_V3_REFRESH_ALWAYS) != live)
+        continue;
+
+      if (!this->dynamic_command_queue_.empty() && this->can_coalesce_(this->dynamic_command_queue_.back(), cmd)) {
+        SeplosV3Command &merged = this->dynamic_command_queue_.back();
+        merged.reg_count = cmd.reg_start + cmd.reg_count - merged.reg_start;
+        ESP_LOGD(TAG, "Merged register 0x%04X into the read of 0x%04X (%d registers)", cmd.reg_start,
+                 merged.reg_start, merged.reg_count);
+        continue;
+      }
+      this->dynamic_command_queue_.push_back(cmd);
+    }
+  };
 
-  // Add pack-specific commands only for registered pack sensors
-  // This ensures commands are only sent to addresses that have corresponding pack components
-  for (const auto *pack_device : this->pack_devices_) {
-    uint8_t pack_address = pack_device->get_address();
-    ESP_LOGD(TAG, "Adding pack commands for registered address: 0x%02X", pack_address);
+  // Live system data first (always present)
+  add_system_commands(true);
 
+  // PIA (0x1000) and PIB (0x1100) are too far apart for a single read and stay separate
+  auto add_pack_commands = [this](uint8_t pack_address) {
     for (const auto &pack_cmd : SEPLOS_V3_PACK_COMMANDS) {
       SeplosV3Command cmd = pack_cmd;
       cmd.device = pack_address;
       this->dynamic_command_queue_.push_back(cmd);
     }
+  };
+
+  if (this->auto_discover_packs_) {
+    // Every pack reported by EIA is polled, with or without a pack component
+    ESP_LOGD(TAG, "Adding pack commands for %d discovered packs", this->pack_count_);
+    for (uint8_t pack_address = 1; pack_address <= this->pack_count_; pack_address++) {
+      add_pack_commands(pack_address);
+    }
+  } else {
+    // Add pack-specific commands only for registered pack sensors
+    // This ensures commands are only sent to addresses that have corresponding pack components
+    for (const auto *pack_device : this->pack_devices_) {
+      uint8_t pack_address = pack_device->get_address();
+      ESP_LOGD(TAG, "Adding pack commands for registered address: 0x%02X", pack_address);
+      add_pack_commands(pack_address);
+    }
+  }
+
+  // Static system data last, it is requested on connect and every few cycles only
+  add_system_commands(false);
+
+  // Commands surviving the rebuild keep their statistics and received flag, otherwise a pack count change would
+  // request the static blocks (VIA, ...) of the system again
+  std::vector<SeplosV3CommandStats> command_stats(this->dynamic_command_queue_.size());
+  std::vector<bool> command_received(this->dynamic_command_queue_.size(), false);
+  for (size_t i = 0; i < this->dynamic_command_queue_.size(); i++) {
+    const SeplosV3Command &cmd = this->dynamic_command_queue_[i];
+    for (size_t j = 0; j < previous_queue.size() && j < this->command_stats_.size(); j++) {
+      const SeplosV3Command &previous = previous_queue[j];
+      if (previous.device == cmd.device && previous.function == cmd.function && previous.reg_start == cmd.reg_start &&
+          previous.reg_count == cmd.reg_count) {
+        command_stats[i] = this->command_stats_[j];
+        command_received[i] = this->command_received_[j];
+        break;
+      }
+    }
   }
+  this->command_stats_ = std::move(command_stats);
+  this->command_received_ = std::move(command_received);
+
+  ESP_LOGD(TAG, "Built dynamic command queue with %zu commands for %zu packs", this->dynamic_command_queue_.size(),
+           this->auto_discover_packs_ ? (size_t) this->pack_count_ : this->pack_devices_.size());
+}
+
+bool SeplosBmsV3Ble::can_coalesce_(const SeplosV3Command &first, const SeplosV3Command &next) const {
+  // Coil reads address bits instead of registers and are never merged
+  if (first.device != next.device || first.function != SEPLOS_V3_CMD_READ_04 || next.function != first.function ||
+      first.refresh_cycles != next.refresh_cycles)
+    return false;
+
+  const uint16_t first_end = first.reg_start + first.reg_count;
+  if (next.reg_start < first_end || next.reg_start - first_end > SEPLOS_V3_MAX_COALESCE_GAP)
+    return false;
 
-  ESP_LOGD(TAG, "Built dynamic command queue with %zu commands for %zu registered packs",
-           this->dynamic_command_queue_.size(), this->pack_devices_.size());
+  // The merged response has to fit into a single read and a single notification
+  const uint16_t reg_count = next.reg_start + next.reg_count - first.reg_start;
+  const size_t frame_size = 3 + reg_count * 2 + 2;
+  return reg_count <= SEPLOS_V3_MAX_READ_REGISTERS && frame_size <= MAX_RESPONSE_SIZE &&
+         frame_size <= (size_t) (this->mtu_ - BLE_NOTIFY_OVERHEAD);
 }
 
 }  // namespace esphome::seplos_bms_v3_ble
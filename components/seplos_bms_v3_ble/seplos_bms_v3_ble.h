@@ -1,9 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 #include "esphome/core/component.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/text_sensor/text_sensor.h"
+#include "esphome/components/seplos_ble/byte_view.h"
+#include "esphome/components/seplos_ble/local_mtu.h"
 
 #ifdef USE_ESP32
 #include "esphome/components/ble_client/ble_client.h"
@@ -17,13 +22,27 @@ namespace esphome::seplos_bms_v3_ble {
 namespace espbt = esphome::esp32_ble_tracker;
 #endif
 
+// ATT MTU before the exchange and the notification payload overhead (opcode + handle)
+static const uint16_t BLE_DEFAULT_MTU = 23;
+static const uint8_t BLE_NOTIFY_OVERHEAD = 3;
+
+// Size of the frame assembly buffer, the largest Modbus-RTU response has 260 bytes
+static const uint16_t MAX_RESPONSE_SIZE = 300;
+
+// Requests of the poll cycle which may await their responses at the same time
+static const uint8_t MAX_REQUESTS_IN_FLIGHT = 3;
+// Timed out requests which may still be answered: each request in flight and the abandoned ones of the last cycle
+static const uint8_t MAX_EXPIRED_REQUESTS = 2 * MAX_REQUESTS_IN_FLIGHT;
+
+using seplos_ble::ByteView;
+
 class SeplosBmsV3Ble;
 
 class SeplosBmsV3BlePack {
  public:
   void set_parent(SeplosBmsV3Ble *parent) { parent_ = parent; }
   void set_address(uint8_t address) { address_ = address; }
-  virtual void on_frame_data(const std::vector<uint8_t> &frame) = 0;
+  virtual void on_frame_data(ByteView frame) = 0;
   uint8_t get_address() const { return address_; }
 
  protected:
@@ -37,6 +56,30 @@ struct SeplosV3Command {
   uint8_t function;
   uint16_t reg_start;
   uint16_t reg_count;
+  uint16_t refresh_cycles;  // Requested every n-th poll cycle, 0 = once per connection
+};
+
+// Request of the poll cycle awaiting its response
+struct SeplosV3Request {
+  uint8_t command;  // Index into the command queue
+  uint8_t device;
+  uint8_t function;
+  uint8_t byte_count;  // Byte count field of the expected response
+  uint16_t reg_start;
+  uint16_t reg_count;
+  uint8_t retries;
+  uint32_t sent_at;
+};
+
+// Response statistics of a command of the poll cycle
+struct SeplosV3CommandStats {
+  uint32_t requests{0};
+  uint32_t responses{0};
+  uint32_t timeouts{0};
+  uint32_t skipped{0};
+  uint32_t last_latency{0};
+  uint32_t max_latency{0};
+  uint32_t total_latency{0};
 };
 
 class SeplosBmsV3Ble :
@@ -49,7 +92,9 @@ class SeplosBmsV3Ble :
   void gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                            esp_ble_gattc_cb_param_t *param) override;
 #endif
+  void setup() override;
   void dump_config() override;
+  void loop() override;
   void update() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
@@ -286,10 +331,24 @@ class SeplosBmsV3Ble :
   void register_pack_component(SeplosBmsV3BlePack *pack_device) {
     pack_devices_.push_back(pack_device);
     // Note: Command queue will be built during setup/connection to include commands for registered packs
+    // (or for the discovered packs if auto_discover_packs_ is set)
   }
 
+  void set_response_timeout(uint16_t response_timeout) { response_timeout_ = response_timeout; }
+  void set_max_retries(uint8_t max_retries) { max_retries_ = max_retries; }
+  void set_max_requests_in_flight(uint8_t max_requests_in_flight) {
+    max_requests_in_flight_ = std::min(max_requests_in_flight, MAX_REQUESTS_IN_FLIGHT);
+  }
+  void set_mtu(uint16_t mtu) {
+    requested_mtu_ = mtu;
+    seplos_ble::request_local_mtu(mtu);
+  }
+  void set_auto_discover_packs(bool auto_discover_packs) { auto_discover_packs_ = auto_discover_packs; }
+  uint16_t get_mtu() const { return mtu_; }
+  const SeplosV3CommandStats &get_command_stats(size_t index) const { return command_stats_[index]; }
+
   void assemble(const uint8_t *data, uint16_t length);
-  void decode(const std::vector<uint8_t> &data);
+  void decode(ByteView data);
 
  protected:
   binary_sensor::BinarySensor *charging_binary_sensor_{nullptr};
@@ -377,18 +436,42 @@ class SeplosBmsV3Ble :
   text_sensor::TextSensor *inverter_protocol_name_text_sensor_{nullptr};
   text_sensor::TextSensor *inverter_protocol_version_text_sensor_{nullptr};
 
-  std::vector<uint8_t> frame_buffer_;
+  uint8_t frame_buffer_[MAX_RESPONSE_SIZE];
+  uint16_t frame_length_{0};
 #ifdef USE_ESP32
   uint16_t char_notify_handle_{0};
   uint16_t char_command_handle_{0};
 #endif
   uint8_t next_command_{0};
-  uint16_t pending_reg_start_{0};
   uint8_t pack_count_{0};
+  // Poll the packs reported by EIA instead of the packs with a pack component, assuming addresses 1..N
+  bool auto_discover_packs_{false};
+  uint8_t queue_pack_count_{0};
   std::vector<SeplosBmsV3BlePack *> pack_devices_;
   std::vector<SeplosV3Command> dynamic_command_queue_;
+
+  // Poll cycle: up to max_requests_in_flight_ commands await their responses, a command is retried or skipped if
+  // its response is lost. The pending requests are kept in the order they were sent
+  uint16_t response_timeout_{500};
+  uint8_t max_retries_{1};
+  uint8_t max_requests_in_flight_{1};
+  SeplosV3Request requests_[MAX_REQUESTS_IN_FLIGHT]{};
+  uint8_t request_count_{0};
+  // Timed out and abandoned requests may still be answered for another response timeout (sent_at holds the time
+  // they expired). No request with a response of the same size is sent meanwhile
+  SeplosV3Request expired_requests_[MAX_EXPIRED_REQUESTS]{};
+  uint8_t expired_count_{0};
+  bool polling_{false};
+
+  // Requested and negotiated ATT MTU of the connection
+  uint16_t requested_mtu_{247};
+  uint16_t mtu_{BLE_DEFAULT_MTU};
+  uint16_t queue_mtu_{0};
+  uint32_t cycle_start_{0};
+  uint32_t poll_cycle_{0};
+  std::vector<bool> command_received_;
+  std::vector<SeplosV3CommandStats> command_stats_;
   std::vector<uint8_t> build_modbus_payload_(const SeplosV3Command &cmd);
-  uint16_t crc16_(const uint8_t *data, uint16_t length);
 
   void publish_state_(binary_sensor::BinarySensor *binary_sensor, const bool &state);
   void publish_state_(sensor::Sensor *sensor, float value);
@@ -396,15 +479,31 @@ class SeplosBmsV3Ble :
 #ifdef USE_ESP32
   bool send_command_(uint8_t function, const std::vector<uint8_t> &payload);
 #endif
-  void decode_eia_data_(const std::vector<uint8_t> &data);
-  void decode_eib_data_(const std::vector<uint8_t> &data);
-  void decode_eic_data_(const std::vector<uint8_t> &data);
-  void decode_via_data_(const std::vector<uint8_t> &data);
-  void decode_pct_data_(const std::vector<uint8_t> &data);
-  void decode_sfa_data_(const std::vector<uint8_t> &data);
-  void decode_spa1_data_(const std::vector<uint8_t> &data);
-  void decode_spa2_data_(const std::vector<uint8_t> &data);
+  void decode_eia_data_(ByteView data);
+  void decode_eib_data_(ByteView data);
+  void decode_eic_data_(ByteView data);
+  void decode_via_data_(ByteView data);
+  void decode_pct_data_(ByteView data);
+  void decode_sfa_data_(ByteView data);
+  void decode_spa1_data_(ByteView data);
+  void decode_spa2_data_(ByteView data);
+  void decode_system_blocks_(const SeplosV3Request &request, ByteView payload);
+  void decode_system_block_(uint16_t reg_start, ByteView data);
   void build_dynamic_command_queue_();
+  bool can_coalesce_(const SeplosV3Command &first, const SeplosV3Command &next) const;
+  void on_mtu_negotiated_(uint16_t mtu);
+  size_t consume_frames_(const uint8_t *raw, size_t available);
+  void start_poll_cycle_(uint32_t now);
+  void fill_pipeline_(uint32_t now);
+  bool command_due_(uint8_t command) const;
+  void send_request_(uint8_t command, uint8_t retries, uint32_t now);
+  bool take_request_(uint8_t device, uint8_t function, uint8_t byte_count, SeplosV3Request *request);
+  bool take_expired_request_(uint8_t device, uint8_t function, uint8_t byte_count, SeplosV3Request *request);
+  bool response_pending_(uint8_t device, uint8_t function, uint8_t byte_count) const;
+  void remove_request_(uint8_t index);
+  void expire_request_(const SeplosV3Request &request, uint32_t now);
+  void complete_request_(const SeplosV3Request &request, uint32_t now);
+  void check_command_timeout_(uint32_t now);
 };
 
 }  // namespace esphome::seplos_bms_v3_ble
@@ -52,9 +52,9 @@ void SeplosBmsV3BlePack::publish_state_(sensor::Sensor *sensor, float value) {
   }
 }
 
-void SeplosBmsV3BlePack::on_frame_data(const std::vector<uint8_t> &frame) {
+void SeplosBmsV3BlePack::on_frame_data(ByteView frame) {
   uint16_t data_len = frame[2];
-  std::vector<uint8_t> payload(frame.begin() + 3, frame.end() - 2);
+  ByteView payload = frame.subview(3, frame.size() - 5);
 
   ESP_LOGD(TAG, "Received frame for pack 0x%02X: function=0x%02X, length=%d", frame[0], frame[1], data_len);
 
@@ -74,7 +74,7 @@ void SeplosBmsV3BlePack::on_frame_data(const std::vector<uint8_t> &frame) {
   }
 }
 
-void SeplosBmsV3BlePack::decode_pack_pia_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3BlePack::decode_pack_pia_data_(ByteView data) {
   auto seplos_get_16bit = [&](size_t i) -> uint16_t {
     return (uint16_t(data[i + 0]) << 8) | (uint16_t(data[i + 1]) << 0);
   };
@@ -92,7 +92,7 @@ void SeplosBmsV3BlePack::decode_pack_pia_data_(const std::vector<uint8_t> &data)
   this->publish_state_(this->pack_cycle_sensor_, (float) seplos_get_16bit(14));
 }
 
-void SeplosBmsV3BlePack::decode_pack_pib_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3BlePack::decode_pack_pib_data_(ByteView data) {
   auto seplos_get_16bit = [&](size_t i) -> uint16_t {
     return (uint16_t(data[i + 0]) << 8) | (uint16_t(data[i + 1]) << 0);
   };
@@ -120,7 +120,7 @@ void SeplosBmsV3BlePack::decode_pack_pib_data_(const std::vector<uint8_t> &data)
   this->publish_state_(this->mosfet_temperature_sensor_, (seplos_get_16bit(50) - 2731.5f) * 0.1f);
 }
 
-void SeplosBmsV3BlePack::decode_pack_pic_data_(const std::vector<uint8_t> &data) {
+void SeplosBmsV3BlePack::decode_pack_pic_data_(ByteView data) {
   ESP_LOGD(TAG, "Decoding PIC data for pack 0x%02X (%zu bytes)", this->get_address(), data.size());
 
   if (data.size() < 288) {  // 0x90 * 2 = 288 bytes
@@ -2,10 +2,13 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/sensor/sensor.h"
+#include "esphome/components/seplos_ble/byte_view.h"
 #include "../seplos_bms_v3_ble/seplos_bms_v3_ble.h"
 
 namespace esphome::seplos_bms_v3_ble_pack {
 
+using seplos_ble::ByteView;
+
 class SeplosBmsV3BlePack : public Component, public seplos_bms_v3_ble::SeplosBmsV3BlePack {
  public:
   void setup() override;
@@ -25,12 +28,12 @@ class SeplosBmsV3BlePack : public Component, public seplos_bms_v3_ble::SeplosBms
   void set_ambient_temperature_sensor(sensor::Sensor *sensor) { ambient_temperature_sensor_ = sensor; }
   void set_mosfet_temperature_sensor(sensor::Sensor *sensor) { mosfet_temperature_sensor_ = sensor; }
 
-  void on_frame_data(const std::vector<uint8_t> &frame) override;
+  void on_frame_data(ByteView frame) override;
 
  protected:
-  void decode_pack_pia_data_(const std::vector<uint8_t> &data);
-  void decode_pack_pib_data_(const std::vector<uint8_t> &data);
-  void decode_pack_pic_data_(const std::vector<uint8_t> &data);
+  void decode_pack_pia_data_(ByteView data);
+  void decode_pack_pib_data_(ByteView data);
+  void decode_pack_pic_data_(ByteView data);
   void publish_state_(sensor::Sensor *sensor, float value);
 
   sensor::Sensor *pack_voltage_sensor_{nullptr};
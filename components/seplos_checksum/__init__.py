@@ -0,0 +1,5 @@
+CODEOWNERS = ["@syssi"]
+
+# Checksum engines shared by the Seplos protocols. The CRC functions use 16-entry nibble
+# tables by default. Add `-DSEPLOS_CHECKSUM_FULL_TABLE` to the build flags to switch to
+# 256-entry tables (512 bytes per CRC) for faster checksums.
@@ -0,0 +1,96 @@
+#include "seplos_checksum.h"
+
+#include <array>
+
+namespace esphome::seplos_checksum {
+
+static const uint16_t CRC16_XMODEM_POLY = 0x1021;
+static const uint16_t CRC16_MODBUS_POLY = 0xA001;
+
+// Shifts `bits` bits of the MSB aligned value through the generator polynomial
+static constexpr uint16_t crc16_msb_step(uint16_t crc, uint8_t bits) {
+  for (uint8_t i = 0; i < bits; i++) {
+    crc = (crc & 0x8000) ? (crc << 1) ^ CRC16_XMODEM_POLY : crc << 1;
+  }
+  return crc;
+}
+
+// Shifts `bits` bits of the LSB aligned value through the reflected generator polynomial
+static constexpr uint16_t crc16_lsb_step(uint16_t crc, uint8_t bits) {
+  for (uint8_t i = 0; i < bits; i++) {
+    crc = (crc & 0x0001) ? (crc >> 1) ^ CRC16_MODBUS_POLY : crc >> 1;
+  }
+  return crc;
+}
+
+template<size_t N> static constexpr std::array<uint16_t, N> make_msb_table() {
+  std::array<uint16_t, N> table{};
+  const uint8_t bits = (N == 16) ? 4 : 8;
+  for (size_t i = 0; i < N; i++) {
+    table[i] = crc16_msb_step(uint16_t(i << (16 - bits)), bits);
+  }
+  return table;
+}
+
+template<size_t N> static constexpr std::array<uint16_t, N> make_lsb_table() {
+  std::array<uint16_t, N> table{};
+  const uint8_t bits = (N == 16) ? 4 : 8;
+  for (size_t i = 0; i < N; i++) {
+    table[i] = crc16_lsb_step(uint16_t(i), bits);
+  }
+  return table;
+}
+
+static constexpr std::array<uint16_t, 16> CRC16_XMODEM_NIBBLE_TABLE = make_msb_table<16>();
+static constexpr std::array<uint16_t, 256> CRC16_XMODEM_TABLE = make_msb_table<256>();
+static constexpr std::array<uint16_t, 16> CRC16_MODBUS_NIBBLE_TABLE = make_lsb_table<16>();
+static constexpr std::array<uint16_t, 256> CRC16_MODBUS_TABLE = make_lsb_table<256>();
+
+uint16_t crc16_xmodem_update_nibble(uint16_t crc, const uint8_t *data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    crc = (crc << 4) ^ CRC16_XMODEM_NIBBLE_TABLE[((crc >> 12) ^ (data[i] >> 4)) & 0x0F];
+    crc = (crc << 4) ^ CRC16_XMODEM_NIBBLE_TABLE[((crc >> 12) ^ (data[i] & 0x0F)) & 0x0F];
+  }
+  return crc;
+}
+
+uint16_t crc16_xmodem_update_table(uint16_t crc, const uint8_t *data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    crc = (crc << 8) ^ CRC16_XMODEM_TABLE[((crc >> 8) ^ data[i]) & 0xFF];
+  }
+  return crc;
+}
+
+uint16_t crc16_modbus_update_nibble(uint16_t crc, const uint8_t *data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    crc = (crc >> 4) ^ CRC16_MODBUS_NIBBLE_TABLE[crc & 0x0F];
+    crc = (crc >> 4) ^ CRC16_MODBUS_NIBBLE_TABLE[crc & 0x0F];
+  }
+  return crc;
+}
+
+uint16_t crc16_modbus_update_table(uint16_t crc, const uint8_t *data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    crc = (crc >> 8) ^ CRC16_MODBUS_TABLE[(crc ^ data[i]) & 0xFF];
+  }
+  return crc;
+}
+
+#ifdef SEPLOS_CHECKSUM_FULL_TABLE
+uint16_t crc16_xmodem_update(uint16_t crc, const uint8_t *data, size_t length) {
+  return crc16_xmodem_update_table(crc, data, length);
+}
+uint16_t crc16_modbus_update(uint16_t crc, const uint8_t *data, size_t length) {
+  return crc16_modbus_update_table(crc, data, length);
+}
+#else
+uint16_t crc16_xmodem_update(uint16_t crc, const uint8_t *data, size_t length) {
+  return crc16_xmodem_update_nibble(crc, data, length);
+}
+uint16_t crc16_modbus_update(uint16_t crc, const uint8_t *data, size_t length) {
+  return crc16_modbus_update_nibble(crc, data, length);
+}
+#endif
+
+}  // namespace esphome::seplos_checksum
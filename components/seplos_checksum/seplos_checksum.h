@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome::seplos_checksum {
+
+// CRC-16/XMODEM (poly 0x1021, MSB first) used by the Seplos BLE protocol
+static const uint16_t CRC16_XMODEM_INIT = 0x0000;
+// CRC-16/MODBUS (poly 0x8005 reflected, LSB first) used by the Seplos V3 protocol
+static const uint16_t CRC16_MODBUS_INIT = 0xFFFF;
+
+// Incremental updates: start with the init value and feed the frame chunk by chunk
+uint16_t crc16_xmodem_update(uint16_t crc, const uint8_t *data, size_t length);
+uint16_t crc16_modbus_update(uint16_t crc, const uint8_t *data, size_t length);
+
+inline uint16_t crc16_xmodem(const uint8_t *data, size_t length) {
+  return crc16_xmodem_update(CRC16_XMODEM_INIT, data, length);
+}
+inline uint16_t crc16_modbus(const uint8_t *data, size_t length) {
+  return crc16_modbus_update(CRC16_MODBUS_INIT, data, length);
+}
+
+// Engines behind the functions above. The nibble table variant is used unless
+// SEPLOS_CHECKSUM_FULL_TABLE is defined. Unused engines are dropped by the linker.
+uint16_t crc16_xmodem_update_nibble(uint16_t crc, const uint8_t *data, size_t length);
+uint16_t crc16_xmodem_update_table(uint16_t crc, const uint8_t *data, size_t length);
+uint16_t crc16_modbus_update_nibble(uint16_t crc, const uint8_t *data, size_t length);
+uint16_t crc16_modbus_update_table(uint16_t crc, const uint8_t *data, size_t length);
+
+// Seplos V2 RS485 checksum: two's complement of the sum of the ASCII characters
+inline uint16_t sum16_update(uint16_t sum, const uint8_t *data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    sum += data[i];
+  }
+  return sum;
+}
+inline uint16_t sum16_finalize(uint16_t sum) { return ~sum + 1; }
+
+}  // namespace esphome::seplos_checksum
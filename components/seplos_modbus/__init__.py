@@ -6,11 +6,15 @@ from esphome.const import CONF_ADDRESS, CONF_FLOW_CONTROL_PIN, CONF_ID
 from esphome.cpp_helpers import gpio_pin_expression
 
 DEPENDENCIES = ["uart"]
+AUTO_LOAD = ["seplos_checksum"]
 CODEOWNERS = ["@syssi"]
 MULTI_CONF = True
 
 CONF_SEPLOS_MODBUS_ID = "seplos_modbus_id"
 CONF_RX_TIMEOUT = "rx_timeout"
+CONF_RESPONSE_TIMEOUT = "response_timeout"
+CONF_TURNAROUND_GAP = "turnaround_gap"
+CONF_GUARD_TIME = "guard_time"
 CONF_PROTOCOL_VERSION = "protocol_version"
 CONF_OVERRIDE_PACK = "override_pack"
 
@@ -26,7 +30,16 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_RX_TIMEOUT, default="150ms"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_RESPONSE_TIMEOUT, default="1000ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_TURNAROUND_GAP, default="50ms"
+            ): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_FLOW_CONTROL_PIN): pins.gpio_output_pin_schema,
+            cv.Optional(
+                CONF_GUARD_TIME, default="1ms"
+            ): cv.positive_time_period_microseconds,
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
@@ -41,9 +54,12 @@ async def to_code(config):
     await uart.register_uart_device(var, config)
 
     cg.add(var.set_rx_timeout(config[CONF_RX_TIMEOUT]))
+    cg.add(var.set_response_timeout(config[CONF_RESPONSE_TIMEOUT]))
+    cg.add(var.set_turnaround_gap(config[CONF_TURNAROUND_GAP]))
     if CONF_FLOW_CONTROL_PIN in config:
         pin = await gpio_pin_expression(config[CONF_FLOW_CONTROL_PIN])
         cg.add(var.set_flow_control_pin(pin))
+    cg.add(var.set_guard_time(config[CONF_GUARD_TIME]))
 
 
 def seplos_modbus_device_schema(default_protocol_version, default_address):
@@ -1,25 +1,44 @@
 #include "seplos_modbus.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "esphome/components/seplos_checksum/seplos_checksum.h"
+#include <algorithm>
+#include <cinttypes>
+
+#ifdef USE_ESP_IDF
+#include "esphome/components/uart/uart_component_esp_idf.h"
+#include <driver/uart.h>
+#endif
 
 namespace esphome::seplos_modbus {
 
 static const char *const TAG = "seplos_modbus";
 
-static const uint16_t MAX_RESPONSE_SIZE = 340;
+// Upper bound of the adaptive turnaround gap
+static const uint16_t MAX_TURNAROUND_GAP = 1000;
 
 void SeplosModbus::setup() {
   if (this->flow_control_pin_ != nullptr) {
     this->flow_control_pin_->setup();
   }
+
+  // start bit + data bits + parity bit + stop bits
+  const uint32_t bits_per_char = 1 + this->parent_->get_data_bits() +
+                                 (this->parent_->get_parity() != uart::UART_CONFIG_PARITY_NONE ? 1 : 0) +
+                                 this->parent_->get_stop_bits();
+  this->char_duration_ = bits_per_char * 1000000UL / this->parent_->get_baud_rate();
 }
 void SeplosModbus::loop() {
+  if (this->transmitting_) {
+    this->check_transmission_(micros());
+  }
+
   const uint32_t now = millis();
 
   if (now - this->last_seplos_modbus_byte_ > this->rx_timeout_) {
     ESP_LOGVV(TAG, "Buffer cleared due to timeout: %s",
-              format_hex_pretty(&this->rx_buffer_.front(), this->rx_buffer_.size()).c_str());  // NOLINT
-    this->rx_buffer_.clear();
+              format_hex_pretty(this->rx_buffer_, this->rx_buffer_len_).c_str());  // NOLINT
+    this->reset_rx_buffer_();
     this->last_seplos_modbus_byte_ = now;
   }
 
@@ -30,20 +49,130 @@ void SeplosModbus::loop() {
       this->last_seplos_modbus_byte_ = now;
     } else {
       ESP_LOGVV(TAG, "Buffer cleared due to reset: %s",
-                format_hex_pretty(&this->rx_buffer_.front(), this->rx_buffer_.size()).c_str());  // NOLINT
-      this->rx_buffer_.clear();
+                format_hex_pretty(this->rx_buffer_, this->rx_buffer_len_).c_str());  // NOLINT
+      this->reset_rx_buffer_();
     }
   }
+
+  this->process_request_queue_(now);
 }
 
-uint16_t chksum(const uint8_t data[], const uint16_t len) {
-  uint16_t checksum = 0x00;
-  for (uint16_t i = 0; i < len; i++) {
-    checksum = checksum + data[i];
+void SeplosModbus::check_transmission_(uint32_t now) {
+#ifdef USE_ESP_IDF
+  // The driver reports once the stop bit of the last character has left the shift register. The guard time
+  // starts from there instead of the estimated frame duration
+  if (!this->tx_done_) {
+    auto *uart = static_cast<uart::IDFUARTComponent *>(this->parent_);
+    if (uart_wait_tx_done((uart_port_t) uart->get_hw_serial_number(), 0) != ESP_OK)
+      return;
+    this->tx_done_ = true;
+    this->tx_start_ = now;
+    this->tx_duration_ = 0;
   }
-  checksum = ~checksum;
-  checksum += 1;
-  return checksum;
+#endif
+  if (now - this->tx_start_ < this->tx_duration_ + this->guard_time_)
+    return;
+
+  this->release_bus_();
+}
+
+void SeplosModbus::release_bus_() {
+  if (this->flow_control_pin_ != nullptr)
+    this->flow_control_pin_->digital_write(false);
+
+  this->transmitting_ = false;
+  this->high_freq_.stop();
+
+  // The response deadline starts once the request has left the bus
+  this->last_send_ = millis();
+}
+
+void SeplosModbus::process_request_queue_(uint32_t now) {
+  if (this->transmitting_)
+    return;
+
+  if (this->waiting_for_response_) {
+    if (now - this->last_send_ < this->response_timeout_)
+      return;
+
+    // Back off if the bus is too slow or a device is flaky
+    this->current_turnaround_gap_ = std::min<uint16_t>(this->current_turnaround_gap_ * 2, MAX_TURNAROUND_GAP);
+    ESP_LOGW(TAG, "No response from address 0x%02X (function 0x%02X) within %d ms. Turnaround gap: %d ms",
+             this->pending_request_.address, this->pending_request_.function, this->response_timeout_,
+             this->current_turnaround_gap_);
+    this->waiting_for_response_ = false;
+    this->last_request_completed_ = now;
+  }
+
+  // Don't talk while somebody else is transmitting
+  if (this->queue_size_ == 0 || this->rx_position_ > 0)
+    return;
+
+  if (now - this->last_request_completed_ < this->current_turnaround_gap_)
+    return;
+
+  this->pending_request_ = this->queue_[this->queue_head_];
+  this->queue_head_ = (this->queue_head_ + 1) % MAX_QUEUED_REQUESTS;
+  this->queue_size_--;
+
+  this->send_(this->pending_request_);
+  this->waiting_for_response_ = true;
+  this->last_send_ = now;
+}
+
+void SeplosModbus::complete_request_(uint32_t now) {
+  this->waiting_for_response_ = false;
+  this->last_request_completed_ = now;
+
+  if (this->current_turnaround_gap_ > this->turnaround_gap_) {
+    this->current_turnaround_gap_ = std::max<uint16_t>(this->current_turnaround_gap_ / 2, this->turnaround_gap_);
+  }
+}
+
+bool SeplosModbus::queue_request(uint8_t address, uint8_t function, const uint8_t *frame, uint8_t frame_length) {
+  for (uint8_t i = 0; i < this->queue_size_; i++) {
+    if (this->queue_[(this->queue_head_ + i) % MAX_QUEUED_REQUESTS].frame == frame) {
+      ESP_LOGD(TAG, "Request 0x%02X to address 0x%02X already queued", function, address);
+      return true;
+    }
+  }
+
+  if (this->queue_size_ >= MAX_QUEUED_REQUESTS) {
+    ESP_LOGW(TAG, "Request queue full. Dropping request 0x%02X to address 0x%02X", function, address);
+    return false;
+  }
+
+  SeplosModbusRequest &request = this->queue_[(this->queue_head_ + this->queue_size_) % MAX_QUEUED_REQUESTS];
+  request.address = address;
+  request.function = function;
+  request.frame = frame;
+  request.frame_length = frame_length;
+  this->queue_size_++;
+
+  return true;
+}
+
+void SeplosModbus::register_device(SeplosModbusDevice *device) {
+  this->devices_.push_back(device);
+
+  uint8_t &index = this->dispatch_[device->address_];
+  if (index == 0) {
+    index = this->devices_.size();
+    return;
+  }
+
+  SeplosModbusDevice *last = this->devices_[index - 1];
+  while (last->next_ != nullptr)
+    last = last->next_;
+  last->next_ = device;
+}
+
+void SeplosModbus::reset_rx_buffer_() {
+  this->rx_buffer_len_ = 0;
+  this->rx_position_ = 0;
+  this->rx_checksum_ = 0;
+  this->rx_tail_ = 0;
+  this->rx_frame_size_ = 0;
 }
 
 uint16_t lchksum(const uint16_t len) {
@@ -58,35 +187,68 @@ uint16_t lchksum(const uint16_t len) {
   return (lchecksum << 12) + len;  // 4 byte checksum + 12 bytes length
 }
 
-uint8_t ascii_hex_to_byte(char a, char b) {
-  a = (a <= '9') ? a - '0' : (a & 0x7) + 9;
-  b = (b <= '9') ? b - '0' : (b & 0x7) + 9;
-
-  return (a << 4) + b;
+static bool ascii_hex_to_nibble(uint8_t c, uint8_t *nibble) {
+  if (c >= '0' && c <= '9') {
+    *nibble = c - '0';
+  } else if (c >= 'A' && c <= 'F') {
+    *nibble = c - 'A' + 10;
+  } else if (c >= 'a' && c <= 'f') {
+    *nibble = c - 'a' + 10;
+  } else {
+    return false;
+  }
+  return true;
 }
 
-static char byte_to_ascii_hex(uint8_t v) { return v >= 10 ? 'A' + (v - 10) : '0' + v; }
-std::string byte_to_ascii_hex(const uint8_t *data, size_t length) {
-  if (length == 0)
-    return "";
-  std::string ret;
-  ret.resize(2 * length);
-  for (size_t i = 0; i < length; i++) {
-    ret[2 * i] = byte_to_ascii_hex((data[i] & 0xF0) >> 4);
-    ret[2 * i + 1] = byte_to_ascii_hex(data[i] & 0x0F);
+static uint8_t nibble_to_ascii_hex(uint8_t v) { return v >= 10 ? 'A' + (v - 10) : '0' + v; }
+
+uint8_t encode_request_frame(uint8_t protocol_version, uint8_t address, uint8_t function, const uint8_t *info,
+                             uint8_t info_length, uint8_t *frame) {
+  const uint16_t lenid = lchksum(info_length * 2);
+  const uint8_t header[6] = {
+      protocol_version,     // VER
+      address,              // ADDR
+      0x46,                 // CID1
+      function,             // CID2 (0x42)
+      uint8_t(lenid >> 8),  // LCHKSUM (0xE0)
+      uint8_t(lenid >> 0),  // LENGTH (0x02)
+  };
+
+  uint8_t pos = 0;
+  frame[pos++] = 0x7E;  // SOF
+  for (uint8_t i = 0; i < sizeof(header) + info_length; i++) {
+    const uint8_t value = (i < sizeof(header)) ? header[i] : info[i - sizeof(header)];  // INFO (0x00)
+    frame[pos++] = nibble_to_ascii_hex(value >> 4);
+    frame[pos++] = nibble_to_ascii_hex(value & 0x0F);
   }
-  return ret;
+
+  // CHKSUM (0xFD37)
+  const uint16_t crc = seplos_checksum::sum16_finalize(seplos_checksum::sum16_update(0, frame + 1, pos - 1));
+  frame[pos++] = nibble_to_ascii_hex((crc >> 12) & 0x0F);
+  frame[pos++] = nibble_to_ascii_hex((crc >> 8) & 0x0F);
+  frame[pos++] = nibble_to_ascii_hex((crc >> 4) & 0x0F);
+  frame[pos++] = nibble_to_ascii_hex((crc >> 0) & 0x0F);
+  frame[pos++] = 0x0D;  // EOF
+
+  return pos;
 }
 
 bool SeplosModbus::parse_seplos_modbus_byte_(uint8_t byte) {
-  size_t at = this->rx_buffer_.size();
-  this->rx_buffer_.push_back(byte);
-  const uint8_t *raw = &this->rx_buffer_[0];
+  // A new start of frame inside a frame means the previous frame was truncated. Resync on it
+  if (byte == 0x7E && this->rx_position_ > 0) {
+    ESP_LOGW(TAG, "Frame truncated at position %u. Resyncing", this->rx_position_);
+    this->reset_rx_buffer_();
+  }
+
+  uint16_t at = this->rx_position_++;
 
   // Start of frame
   if (at == 0) {
-    if (raw[0] != 0x7E) {
-      ESP_LOGW(TAG, "Invalid header: 0x%02X", raw[0]);
+    if (byte != 0x7E) {
+      // Skip noise and the EOI of a frame which was completed by its length already
+      if (byte != 0x0D) {
+        ESP_LOGVV(TAG, "Skipping 0x%02X while searching for start of frame", byte);
+      }
 
       // return false to reset buffer
       return false;
@@ -95,41 +257,78 @@ bool SeplosModbus::parse_seplos_modbus_byte_(uint8_t byte) {
     return true;
   }
 
-  // End of frame '\r'
-  if (raw[at] != 0x0D)
-    return true;
+  if (byte == 0x0D) {
+    ESP_LOGW(TAG, "Unexpected end of frame at position %u (expected %u characters)", at - 1, this->rx_frame_size_);
+    return false;
+  }
 
-  if (at > MAX_RESPONSE_SIZE) {
-    ESP_LOGW(TAG, "Maximum response size exceeded. Flushing RX buffer...");
+  uint8_t nibble;
+  if (!ascii_hex_to_nibble(byte, &nibble)) {
+    ESP_LOGW(TAG, "Invalid character 0x%02X at position %u", byte, at);
     return false;
   }
 
-  uint16_t data_len = at - 4 - 1;
-  uint16_t computed_crc = chksum(raw + 1, data_len);
-  uint16_t remote_crc = uint16_t(ascii_hex_to_byte(raw[at - 4], raw[at - 3])) << 8 |
-                        (uint16_t(ascii_hex_to_byte(raw[at - 2], raw[at - 1])) << 0);
+  // A character is added to the checksum as soon as it cannot be part of the trailing checksum anymore
+  if (at > 4) {
+    this->rx_checksum_ += (uint8_t) (this->rx_tail_ >> 24);
+  }
+  this->rx_tail_ = (this->rx_tail_ << 8) | byte;
+
+  if (at & 1) {
+    this->rx_nibble_ = nibble;
+    return true;
+  }
+  this->rx_buffer_[this->rx_buffer_len_++] = (this->rx_nibble_ << 4) | nibble;
+
+  // VER ADR CID1 CID2 LENGTH received: The length of the whole frame is known now
+  if (this->rx_buffer_len_ == 6) {
+    uint16_t length = (uint16_t(this->rx_buffer_[4]) << 8) | (uint16_t(this->rx_buffer_[5]) << 0);
+    uint16_t lenid = length & 0x0FFF;
+    if (lchksum(lenid) != length || (lenid & 1)) {
+      ESP_LOGW(TAG, "Invalid length field: 0x%04X", length);
+      return false;
+    }
+
+    // 12 header characters + INFO + 4 checksum characters
+    this->rx_frame_size_ = 12 + lenid + 4;
+    if (this->rx_frame_size_ > MAX_RESPONSE_SIZE) {
+      ESP_LOGW(TAG, "Maximum response size exceeded (%u characters). Flushing RX buffer...", this->rx_frame_size_);
+      return false;
+    }
+  }
+
+  // The frame is complete once the declared length has arrived. The trailing EOI isn't awaited
+  if (this->rx_frame_size_ == 0 || at < this->rx_frame_size_)
+    return true;
+
+  uint16_t data_len = this->rx_buffer_len_ - 2;
+  uint16_t computed_crc = seplos_checksum::sum16_finalize(this->rx_checksum_);
+  uint16_t remote_crc = (uint16_t(this->rx_buffer_[data_len]) << 8) | (uint16_t(this->rx_buffer_[data_len + 1]) << 0);
   if (computed_crc != remote_crc) {
     ESP_LOGW(TAG, "CRC check failed! 0x%04X != 0x%04X", computed_crc, remote_crc);
     return false;
   }
 
-  std::vector<uint8_t> data;
-  for (uint16_t i = 1; i < data_len; i = i + 2) {
-    data.push_back(ascii_hex_to_byte(raw[i], raw[i + 1]));
-  }
-
+  const uint8_t *data = this->rx_buffer_;
   uint8_t address = data[1];
 
-  bool found = false;
-  for (auto *device : this->devices_) {
-    if (device->address_ == address) {
-      device->on_seplos_modbus_data(data);
-      found = true;
-    }
+  // CID2 of the request answered by this frame. Unsolicited frames (e.g. of another master) are passed as 0x00
+  uint8_t function = 0x00;
+  if (this->waiting_for_response_ && this->pending_request_.address == address) {
+    function = this->pending_request_.function;
+    this->complete_request_(millis());
+  }
+
+  const uint8_t index = this->dispatch_[address];
+  if (index == 0) {
+    this->unknown_address_frames_++;
+    ESP_LOGW(TAG, "Got SeplosModbus frame from unknown address 0x%02X! (%" PRIu32 " frames)", address,
+             this->unknown_address_frames_);
+    return false;
   }
 
-  if (!found) {
-    ESP_LOGW(TAG, "Got SeplosModbus frame from unknown address 0x%02X! ", address);
+  for (SeplosModbusDevice *device = this->devices_[index - 1]; device != nullptr; device = device->next_) {
+    device->on_seplos_modbus_data(function, data, data_len);
   }
 
   // return false to reset buffer
@@ -140,44 +339,74 @@ void SeplosModbus::dump_config() {
   ESP_LOGCONFIG(TAG, "SeplosModbus:");
   LOG_PIN("  Flow Control Pin: ", this->flow_control_pin_);
   ESP_LOGCONFIG(TAG, "  RX timeout: %d ms", this->rx_timeout_);
+  ESP_LOGCONFIG(TAG, "  Response timeout: %d ms", this->response_timeout_);
+  ESP_LOGCONFIG(TAG, "  Turnaround gap: %d ms", this->turnaround_gap_);
+  ESP_LOGCONFIG(TAG, "  Guard time: %" PRIu32 " us", this->guard_time_);
+  ESP_LOGCONFIG(TAG, "  Character transmit time: %" PRIu32 " us", this->char_duration_);
 }
 float SeplosModbus::get_setup_priority() const {
   // After UART bus
   return setup_priority::BUS - 1.0f;
 }
 
-void SeplosModbus::send(uint8_t protocol_version, uint8_t address, uint8_t function, uint8_t value) {
+void SeplosModbus::send_(const SeplosModbusRequest &request) {
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(true);
 
-  const uint16_t lenid = lchksum(1 * 2);
-  std::vector<uint8_t> data;
-  data.push_back(protocol_version);  // VER
-  data.push_back(address);           // ADDR
-  data.push_back(0x46);              // CID1
-  data.push_back(function);          // CID2 (0x42)
-  data.push_back(lenid >> 8);        // LCHKSUM (0xE0)
-  data.push_back(lenid >> 0);        // LENGTH (0x02)
-  data.push_back(value);             // VALUE (0x00)
+  ESP_LOGD(TAG, "Send frame: %.*s", request.frame_length - 1, (const char *) request.frame);
 
-  const uint16_t frame_len = data.size();
-  std::string payload = "~";  // SOF (0x7E)
-  payload.append(byte_to_ascii_hex(data.data(), frame_len));
+  this->write_array(request.frame, request.frame_length);
 
-  uint16_t crc = chksum((const uint8_t *) payload.data() + 1, payload.size() - 1);
-  data.push_back(crc >> 8);  // CHKSUM (0xFD)
-  data.push_back(crc >> 0);  // CHKSUM (0x37)
+  this->tx_duration_ = request.frame_length * this->char_duration_;
+  this->tx_start_ = micros();
+  this->tx_done_ = false;
+  this->transmitting_ = true;
 
-  payload.append(byte_to_ascii_hex(data.data() + frame_len, data.size() - frame_len));  // Append checksum
-  payload.append("\r");                                                                 // EOF (0x0D)
+#ifndef USE_ESP_IDF
+  // Other UART drivers offer no transmit complete indication to poll: the frame duration is an estimate which
+  // ignores the transmit FIFO and interrupt latency. Without a guard time the end of the frame is waited for
+  if (this->guard_time_ == 0) {
+    this->flush();
+    this->release_bus_();
+    return;
+  }
+#endif
 
-  ESP_LOGD(TAG, "Send frame: %s", payload.c_str());
+  this->high_freq_.start();
+}
 
-  this->write_str(payload.c_str());
-  this->flush();
+void SeplosModbusDevice::send(uint8_t function) { this->send_(function, nullptr, 0); }
 
-  if (this->flow_control_pin_ != nullptr)
-    this->flow_control_pin_->digital_write(false);
+void SeplosModbusDevice::send(uint8_t function, uint8_t value) { this->send_(function, &value, 1); }
+
+void SeplosModbusDevice::send_(uint8_t function, const uint8_t *info, uint8_t info_length) {
+  const uint8_t value = (info_length > 0) ? info[0] : 0x00;
+
+  SeplosModbusRequestFrame *entry = nullptr;
+  for (uint8_t i = 0; i < this->request_frames_count_; i++) {
+    SeplosModbusRequestFrame &candidate = this->request_frames_[i];
+    if (candidate.function == function && candidate.info_length == info_length && candidate.value == value) {
+      entry = &candidate;
+      break;
+    }
+  }
+
+  // Every request is encoded once and reused on subsequent polls
+  if (entry == nullptr) {
+    if (this->request_frames_count_ >= MAX_REQUEST_FRAMES) {
+      ESP_LOGE(TAG, "Request frame cache exhausted. Dropping request 0x%02X", function);
+      return;
+    }
+
+    entry = &this->request_frames_[this->request_frames_count_++];
+    entry->function = function;
+    entry->value = value;
+    entry->info_length = info_length;
+    entry->length = encode_request_frame(this->protocol_version_, this->address_, function, info, info_length,
+                                         entry->data);
+  }
+
+  this->parent_->queue_request(this->address_, function, entry->data, entry->length);
 }
 
 }  // namespace esphome::seplos_modbus
@@ -1,10 +1,38 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/uart/uart.h"
 
 namespace esphome::seplos_modbus {
 
+// Maximum number of ASCII characters between SOI (0x7E) and EOI (0x0D)
+static const uint16_t MAX_RESPONSE_SIZE = 340;
+
+// Maximum number of requests waiting for the bus
+static const uint8_t MAX_QUEUED_REQUESTS = 16;
+
+// SOI + 6 bytes header and up to 1 byte INFO ASCII hex encoded + 4 characters checksum + EOI
+static const uint8_t REQUEST_FRAME_SIZE = 20;
+
+// Maximum number of distinct requests per device
+static const uint8_t MAX_REQUEST_FRAMES = 6;
+
+struct SeplosModbusRequest {
+  uint8_t address;
+  uint8_t function;
+  const uint8_t *frame;
+  uint8_t frame_length;
+};
+
+struct SeplosModbusRequestFrame {
+  uint8_t function;
+  uint8_t value;
+  uint8_t info_length;
+  uint8_t length;
+  uint8_t data[REQUEST_FRAME_SIZE];
+};
+
 class SeplosModbusDevice;
 
 class SeplosModbus : public uart::UARTDevice, public Component {
@@ -17,26 +45,80 @@ class SeplosModbus : public uart::UARTDevice, public Component {
 
   void dump_config() override;
 
-  void register_device(SeplosModbusDevice *device) { this->devices_.push_back(device); }
+  void register_device(SeplosModbusDevice *device);
 
   float get_setup_priority() const override;
 
-  void send(uint8_t protocol_version, uint8_t address, uint8_t function, uint8_t value);
+  bool queue_request(uint8_t address, uint8_t function, const uint8_t *frame, uint8_t frame_length);
   void set_rx_timeout(uint16_t rx_timeout) { rx_timeout_ = rx_timeout; }
+  void set_response_timeout(uint16_t response_timeout) { response_timeout_ = response_timeout; }
+  void set_turnaround_gap(uint16_t turnaround_gap) {
+    turnaround_gap_ = turnaround_gap;
+    current_turnaround_gap_ = turnaround_gap;
+  }
   void set_flow_control_pin(GPIOPin *flow_control_pin) { this->flow_control_pin_ = flow_control_pin; }
+  void set_guard_time(uint32_t guard_time) { this->guard_time_ = guard_time; }
+  uint32_t get_unknown_address_frames() const { return this->unknown_address_frames_; }
 
  protected:
   uint16_t rx_timeout_{150};
+  uint16_t response_timeout_{1000};
+  uint16_t turnaround_gap_{50};
+  uint16_t current_turnaround_gap_{50};
   GPIOPin *flow_control_pin_{nullptr};
+  uint32_t guard_time_{1000};
 
   bool parse_seplos_modbus_byte_(uint8_t byte);
-  std::vector<uint8_t> rx_buffer_;
+  void reset_rx_buffer_();
+  void process_request_queue_(uint32_t now);
+  void complete_request_(uint32_t now);
+  void send_(const SeplosModbusRequest &request);
+  void check_transmission_(uint32_t now);
+  void release_bus_();
+
+  // A request is shifted out in the background. The flow control pin is released in loop() once the
+  // frame has left the UART plus the guard time. With ESP-IDF the driver is polled for the end of the
+  // frame. Other drivers release it after the frame duration derived from the UART settings, an estimate
+  // which relies on the guard time to cover the transmit FIFO; a guard time of 0 blocks in flush() instead
+  HighFrequencyLoopRequester high_freq_;
+  bool transmitting_{false};
+  bool tx_done_{false};
+  uint32_t tx_start_{0};
+  uint32_t tx_duration_{0};
+  uint32_t char_duration_{0};
+
+  // One request is outstanding at a time. Further requests wait in a ring buffer
+  // until the response arrives or the response deadline expires.
+  SeplosModbusRequest queue_[MAX_QUEUED_REQUESTS];
+  uint8_t queue_head_{0};
+  uint8_t queue_size_{0};
+  SeplosModbusRequest pending_request_{};
+  bool waiting_for_response_{false};
+  uint32_t last_request_completed_{0};
+
+  // The ASCII hex stream is decoded on the fly into rx_buffer_. The running checksum lags
+  // four characters behind because the trailing four characters are the checksum itself.
+  // The frame size is taken from the LENGTH field as soon as the header is complete.
+  uint8_t rx_buffer_[MAX_RESPONSE_SIZE / 2];
+  uint16_t rx_buffer_len_{0};
+  uint16_t rx_position_{0};
+  uint16_t rx_frame_size_{0};
+  uint16_t rx_checksum_{0};
+  uint32_t rx_tail_{0};
+  uint8_t rx_nibble_{0};
   uint32_t last_seplos_modbus_byte_{0};
   uint32_t last_send_{0};
   std::vector<SeplosModbusDevice *> devices_;
+
+  // Index + 1 of the first device per address (0 = no device). Further devices
+  // of the same address are chained via SeplosModbusDevice::next_
+  uint8_t dispatch_[256]{};
+  uint32_t unknown_address_frames_{0};
 };
 
-uint16_t crc16(const uint8_t *data, uint8_t len);
+uint16_t lchksum(uint16_t len);
+uint8_t encode_request_frame(uint8_t protocol_version, uint8_t address, uint8_t function, const uint8_t *info,
+                             uint8_t info_length, uint8_t *frame);
 
 class SeplosModbusDevice {
  public:
@@ -44,18 +126,22 @@ class SeplosModbusDevice {
   void set_address(uint8_t address) { address_ = address; }
   void set_pack(uint8_t pack) { pack_ = pack; }
   void set_protocol_version(uint8_t protocol_version) { protocol_version_ = protocol_version; }
-  virtual void on_seplos_modbus_data(const std::vector<uint8_t> &data) = 0;
-  void send(uint8_t function, uint8_t value) {
-    this->parent_->send(this->protocol_version_, this->address_, function, value);
-  }
+  virtual void on_seplos_modbus_data(uint8_t function, const uint8_t *data, uint16_t length) = 0;
+  void send(uint8_t function);
+  void send(uint8_t function, uint8_t value);
 
  protected:
   friend SeplosModbus;
 
   SeplosModbus *parent_;
+  SeplosModbusDevice *next_{nullptr};
   uint8_t address_;
   uint8_t pack_;
   uint8_t protocol_version_;
+  SeplosModbusRequestFrame request_frames_[MAX_REQUEST_FRAMES];
+  uint8_t request_frames_count_{0};
+
+  void send_(uint8_t function, const uint8_t *info, uint8_t info_length);
 };
 
 }  // namespace esphome::seplos_modbus
@@ -26,6 +26,9 @@ for dir in "$REPO_DIR"/tests/components/*/; do
     rsync -a --delete "$dir" "$ESPHOME_DIR/tests/components/$component/"
 done
 
+# Helpers shared by the test suites (benchmark harness)
+rsync -a "$REPO_DIR"/tests/components/*.h "$ESPHOME_DIR/tests/components/"
+
 # Set up venv once; delete $VENV_DIR to force reinstall
 if [[ ! -d "$VENV_DIR" ]]; then
     echo "Creating Python venv..."
@@ -38,7 +41,7 @@ fi
 # CI symlinks venv inside the esphome dir
 ln -sfn "$VENV_DIR" "$ESPHOME_DIR/venv"
 
-COMPONENTS=${*:-$(ls "$REPO_DIR/tests/components")}
+COMPONENTS=${*:-$(cd "$REPO_DIR/tests/components" && ls -d */ | tr -d /)}
 
 echo "Running C++ unit tests: $COMPONENTS"
 . "$VENV_DIR/bin/activate"
@@ -0,0 +1,75 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Heap allocation accounting
+//
+// Every allocation through operator new is counted. Tests measure a steady-state poll cycle
+// (after a warm-up cycle has populated lazily allocated state) and fail if the cycle exceeds
+// the allocation budget of the component. The budgets are upper bounds because allocations made to
+// format log arguments depend on the log level of the build.
+//
+// Only operator new is replaced: direct calls to malloc, calloc, realloc or strdup (from the components or
+// from C library functions such as the printf family) are not counted. The components don't call them
+// themselves, a budget of 0 therefore means no C++ allocation rather than no heap use at all.
+
+namespace esphome::allocation {
+
+// Updated by the replacement allocation functions below
+inline size_t allocations = 0;
+inline size_t allocated_bytes = 0;
+
+struct Usage {
+  size_t allocations;
+  size_t bytes;
+};
+
+template<typename F> Usage measure(F &&cycle) {
+  const size_t allocations_before = allocations;
+  const size_t allocated_bytes_before = allocated_bytes;
+  cycle();
+  return {allocations - allocations_before, allocated_bytes - allocated_bytes_before};
+}
+
+// Runs a warm-up cycle, measures a second one and checks it against the budget (operator new only, see above)
+template<typename F> ::testing::AssertionResult within_budget(const char *name, size_t budget, F &&cycle) {
+  cycle();
+  const Usage usage = measure(cycle);
+
+  printf("[ ALLOC    ] %-36s %4zu allocations %6zu bytes (budget %zu)\n", name, usage.allocations, usage.bytes,
+         budget);
+  ::testing::Test::RecordProperty("allocations", (int) usage.allocations);
+  ::testing::Test::RecordProperty("allocated_bytes", (int) usage.bytes);
+
+  if (usage.allocations > budget) {
+    return ::testing::AssertionFailure() << name << " allocates " << usage.allocations << " times (" << usage.bytes
+                                         << " bytes) per cycle, budget is " << budget;
+  }
+  return ::testing::AssertionSuccess();
+}
+
+}  // namespace esphome::allocation
+
+// Replacement allocation functions counting every heap allocation. They are weak because
+// this header is included by the test sources of several components linked into one binary.
+__attribute__((weak)) void *operator new(std::size_t size) {
+  esphome::allocation::allocations++;
+  esphome::allocation::allocated_bytes += size;
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+__attribute__((weak)) void *operator new[](std::size_t size) { return ::operator new(size); }
+
+__attribute__((weak)) void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+__attribute__((weak)) void operator delete[](void *ptr) noexcept { std::free(ptr); }
+
+__attribute__((weak)) void operator delete(void *ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+
+__attribute__((weak)) void operator delete[](void *ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
@@ -0,0 +1,73 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "allocation.h"
+
+// Host-side decoder benchmarks
+//
+// The benchmarks are regular gtest cases named *Benchmark* and can be selected with
+// --gtest_filter='*Benchmark*'. Every case feeds a recorded frame through a decoder until
+// the time budget is used up and reports the time per frame, the throughput and the heap
+// allocations per frame.
+
+namespace esphome::benchmark {
+
+struct Result {
+  uint32_t iterations;
+  double ns_per_frame;
+  double bytes_per_second;
+  double allocations_per_frame;
+  double allocated_bytes_per_frame;
+};
+
+static const auto MIN_DURATION = std::chrono::milliseconds(20);
+
+template<typename F> Result run(const char *name, size_t frame_size, F &&decode) {
+  using clock = std::chrono::steady_clock;
+
+  // Warm up (lazily allocated state, caches)
+  decode();
+
+  uint32_t iterations = 1;
+  clock::duration elapsed{};
+  size_t frame_allocations = 0;
+  size_t frame_allocated_bytes = 0;
+  while (true) {
+    const size_t allocations_before = allocation::allocations;
+    const size_t allocated_bytes_before = allocation::allocated_bytes;
+    const auto start = clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+      decode();
+    }
+    elapsed = clock::now() - start;
+    frame_allocations = allocation::allocations - allocations_before;
+    frame_allocated_bytes = allocation::allocated_bytes - allocated_bytes_before;
+
+    if (elapsed >= MIN_DURATION || iterations >= (1u << 24))
+      break;
+    iterations *= 2;
+  }
+
+  Result result{};
+  result.iterations = iterations;
+  result.ns_per_frame = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+  result.bytes_per_second = frame_size * 1e9 / result.ns_per_frame;
+  result.allocations_per_frame = (double) frame_allocations / iterations;
+  result.allocated_bytes_per_frame = (double) frame_allocated_bytes / iterations;
+
+  printf("[ BENCH    ] %-36s %10.1f ns/frame %9.2f MB/s %6.2f allocs/frame %8.1f bytes/frame (%u x %zu bytes)\n",
+         name, result.ns_per_frame, result.bytes_per_second / 1e6, result.allocations_per_frame,
+         result.allocated_bytes_per_frame, result.iterations, frame_size);
+
+  ::testing::Test::RecordProperty("ns_per_frame", std::to_string(result.ns_per_frame));
+  ::testing::Test::RecordProperty("bytes_per_second", std::to_string(result.bytes_per_second));
+  ::testing::Test::RecordProperty("allocations_per_frame", std::to_string(result.allocations_per_frame));
+
+  return result;
+}
+
+}  // namespace esphome::benchmark
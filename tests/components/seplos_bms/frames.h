@@ -41,4 +41,99 @@ static const std::vector<uint8_t> TELEMETRY_FRAME = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // reserved
 };
 
+// Source: tests/esp8266-seplos-emulator.yaml (response to CID2 0x44)
+// 15 cells, 6 temperature sensors, no alarms
+static const std::vector<uint8_t> ALARM_FRAME = {
+    0x20, 0x00, 0x46, 0x00, 0xA0, 0x60, 0x00, 0x01,  // header
+    0x0F,                                            // cells = 15
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // cell alarms 1-8
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,        // cell alarms 9-15
+    0x06,                                            // temperature sensors = 6
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,              // temperature alarms 1-6
+    0x00,                                            // charge/discharge current alarm
+    0x00,                                            // total voltage alarm
+    0x14,                                            // custom number = 20
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,              // alarm events 1-6
+    0x03,                                            // on-off state
+    0x00, 0x00,                                      // equilibrium state
+    0x02,                                            // system state
+    0x00, 0x00,                                      // disconnection state
+    0x00, 0x00,                                      // alarm events 7-8
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x02,              // reserved
+};
+
+// ALARM_FRAME with cell 3 above upper limit, temperature 2 below lower limit,
+// single overvoltage protection (event 2, bit 1) and charging overcurrent alarm (event 5, bit 0)
+static const std::vector<uint8_t> ALARM_FRAME_WITH_ALARMS = {
+    0x20, 0x00, 0x46, 0x00, 0xA0, 0x60, 0x00, 0x01,  // header
+    0x0F,                                            // cells = 15
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,  // cell alarms 1-8
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,        // cell alarms 9-15
+    0x06,                                            // temperature sensors = 6
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x00,              // temperature alarms 1-6
+    0x00,                                            // charge/discharge current alarm
+    0x00,                                            // total voltage alarm
+    0x14,                                            // custom number = 20
+    0x00, 0x02, 0x00, 0x00, 0x01, 0x00,              // alarm events 1-6
+    0x03,                                            // on-off state
+    0x00, 0x00,                                      // equilibrium state
+    0x02,                                            // system state
+    0x00, 0x00,                                      // disconnection state
+    0x00, 0x00,                                      // alarm events 7-8
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x02,              // reserved
+};
+
+// Response to the all-packs telemetry request (command value 0xFF) of a two pack stack
+// 8 cells, 2 temperature sensors per pack
+// Decoded key values:
+//   pack 1: total_voltage=26.40V  charging_cycles=10
+//   pack 2: total_voltage=26.00V  charging_cycles=20
+static const std::vector<uint8_t> ALL_PACKS_TELEMETRY_FRAME = {
+    0x20, 0x00, 0x46, 0x00, 0xC0, 0xC8, 0x00,        // header, data flag
+    0x02,                                            // packs = 2
+    0x08,                                            // pack 1: cells = 8
+    0x0C, 0xE4, 0x0C, 0xE4, 0x0C, 0xE4, 0x0C, 0xE4,  // cells 1-4
+    0x0C, 0xE4, 0x0C, 0xE4, 0x0C, 0xE4, 0x0C, 0xE4,  // cells 5-8
+    0x02, 0x0B, 0xA6, 0x0B, 0xA6,                    // temperatures
+    0x00, 0x64,                                      // current = 1.00A
+    0x0A, 0x50,                                      // total_voltage = 26.40V
+    0x27, 0x10,                                      // residual_capacity = 100.00Ah
+    0x0A,                                            // custom number = 10
+    0x27, 0x10, 0x03, 0xE8, 0x27, 0x10,              // battery capacity, state of charge, rated capacity
+    0x00, 0x0A, 0x03, 0xE8, 0x0A, 0x50,              // cycles = 10, state of health, port voltage
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // reserved
+    0x08,                                            // pack 2: cells = 8
+    0x0C, 0xB2, 0x0C, 0xB2, 0x0C, 0xB2, 0x0C, 0xB2,  // cells 1-4
+    0x0C, 0xB2, 0x0C, 0xB2, 0x0C, 0xB2, 0x0C, 0xB2,  // cells 5-8
+    0x02, 0x0B, 0xA6, 0x0B, 0xA6,                    // temperatures
+    0x00, 0x64,                                      // current = 1.00A
+    0x0A, 0x28,                                      // total_voltage = 26.00V
+    0x27, 0x10,                                      // residual_capacity = 100.00Ah
+    0x0A,                                            // custom number = 10
+    0x27, 0x10, 0x03, 0xE8, 0x27, 0x10,              // battery capacity, state of charge, rated capacity
+    0x00, 0x14, 0x03, 0xE8, 0x0A, 0x28,              // cycles = 20, state of health, port voltage
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // reserved
+};
+
+// Source: emulator response to 0x4F (get protocol version)
+// protocol_version=2.0
+static const std::vector<uint8_t> PROTOCOL_VERSION_FRAME = {
+    0x20, 0x00, 0x46, 0x00, 0x00, 0x00,  // header
+};
+
+// Source: emulator response to 0x51 (get manufacturer info)
+// device_model="1101-ZH26"  software_version=2.6  manufacturer="" (blank padded)
+static const std::vector<uint8_t> MANUFACTURER_INFO_FRAME = {
+    0x20, 0x00, 0x46, 0x00, 0xC0, 0x40,                          // header
+    0x31, 0x31, 0x30, 0x31, 0x2D, 0x5A, 0x48, 0x32, 0x36, 0x20,  // device name "1101-ZH26 "
+    0x02, 0x06,                                                  // software version 2.6
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,  // manufacturer name
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,  //
+};
+
+// Response with RTN 0x04 (CID2 invalid)
+static const std::vector<uint8_t> REJECTED_FRAME = {
+    0x20, 0x00, 0x46, 0x04, 0x00, 0x00,  // header
+};
+
 }  // namespace esphome::seplos_bms::testing
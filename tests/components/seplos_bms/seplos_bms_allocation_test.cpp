@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include "../allocation.h"
+#include "common.h"
+#include "frames.h"
+
+namespace esphome::seplos_bms::testing {
+
+// Allowed heap allocations per poll cycle (telemetry and alarms)
+static const size_t POLL_CYCLE_ALLOCATION_BUDGET = 0;
+
+TEST(SeplosBmsAllocationTest, PollCycle) {
+  TestableSeplosBms bms;
+  sensor::Sensor cells[16], temperatures[6], total_voltage, current, power, state_of_charge;
+  text_sensor::TextSensor errors;
+  for (int i = 0; i < 16; i++)
+    bms.set_cell_voltage_sensor(i, &cells[i]);
+  for (int i = 0; i < 6; i++)
+    bms.set_temperature_sensor(i, &temperatures[i]);
+  bms.set_total_voltage_sensor(&total_voltage);
+  bms.set_current_sensor(&current);
+  bms.set_power_sensor(&power);
+  bms.set_state_of_charge_sensor(&state_of_charge);
+  bms.set_errors_text_sensor(&errors);
+
+  EXPECT_TRUE(allocation::within_budget("SeplosBms poll cycle", POLL_CYCLE_ALLOCATION_BUDGET, [&]() {
+    bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
+    bms.on_seplos_modbus_data(0x44, ALARM_FRAME_WITH_ALARMS.data(), ALARM_FRAME_WITH_ALARMS.size());
+  }));
+}
+
+}  // namespace esphome::seplos_bms::testing
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "../benchmark.h"
+#include "common.h"
+#include "frames.h"
+
+namespace esphome::seplos_bms::testing {
+
+TEST(SeplosBmsBenchmark, DecodeTelemetryFrame) {
+  TestableSeplosBms bms;
+  sensor::Sensor cells[16], temperatures[6];
+  sensor::Sensor total_voltage, current, power, state_of_charge;
+  for (int i = 0; i < 16; i++)
+    bms.set_cell_voltage_sensor(i, &cells[i]);
+  for (int i = 0; i < 6; i++)
+    bms.set_temperature_sensor(i, &temperatures[i]);
+  bms.set_total_voltage_sensor(&total_voltage);
+  bms.set_current_sensor(&current);
+  bms.set_power_sensor(&power);
+  bms.set_state_of_charge_sensor(&state_of_charge);
+
+  auto result = benchmark::run("SeplosBms::on_telemetry_data_", TELEMETRY_FRAME.size(), [&]() {
+    bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
+  });
+
+  EXPECT_GT(result.iterations, 0u);
+  EXPECT_NEAR(total_voltage.state, 52.80f, 0.01f);
+}
+
+TEST(SeplosBmsBenchmark, DecodeAlarmFrame) {
+  TestableSeplosBms bms;
+  text_sensor::TextSensor errors;
+  bms.set_errors_text_sensor(&errors);
+
+  auto result = benchmark::run("SeplosBms::on_alarm_data_", ALARM_FRAME_WITH_ALARMS.size(), [&]() {
+    bms.on_seplos_modbus_data(0x44, ALARM_FRAME_WITH_ALARMS.data(), ALARM_FRAME_WITH_ALARMS.size());
+  });
+
+  EXPECT_GT(result.iterations, 0u);
+  EXPECT_FALSE(errors.state.empty());
+}
+
+}  // namespace esphome::seplos_bms::testing
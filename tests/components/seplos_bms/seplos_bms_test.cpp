@@ -12,7 +12,7 @@ TEST(SeplosBmsTelemetryTest, CellVoltages) {
   for (int i = 0; i < 16; i++)
     bms.set_cell_voltage_sensor(i, &cells[i]);
 
-  bms.on_seplos_modbus_data(TELEMETRY_FRAME);
+  bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
 
   EXPECT_NEAR(cells[0].state, 3.287f, 0.001f);
   EXPECT_NEAR(cells[1].state, 3.305f, 0.001f);
@@ -32,7 +32,7 @@ TEST(SeplosBmsTelemetryTest, CellVoltageStats) {
   bms.set_delta_cell_voltage_sensor(&delta);
   bms.set_average_cell_voltage_sensor(&avg);
 
-  bms.on_seplos_modbus_data(TELEMETRY_FRAME);
+  bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
 
   EXPECT_NEAR(min_v.state, 3.286f, 0.001f);
   EXPECT_NEAR(max_v.state, 3.316f, 0.001f);
@@ -50,7 +50,7 @@ TEST(SeplosBmsTelemetryTest, Temperatures) {
   for (int i = 0; i < 6; i++)
     bms.set_temperature_sensor(i, &t[i]);
 
-  bms.on_seplos_modbus_data(TELEMETRY_FRAME);
+  bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
 
   EXPECT_NEAR(t[0].state, 25.1f, 0.1f);
   EXPECT_NEAR(t[1].state, 24.5f, 0.1f);
@@ -70,7 +70,7 @@ TEST(SeplosBmsTelemetryTest, CurrentAndPower) {
   bms.set_charging_power_sensor(&charging_power);
   bms.set_discharging_power_sensor(&discharging_power);
 
-  bms.on_seplos_modbus_data(TELEMETRY_FRAME);
+  bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
 
   EXPECT_NEAR(current.state, -6.76f, 0.01f);
   EXPECT_NEAR(power.state, -356.93f, 1.0f);
@@ -85,7 +85,7 @@ TEST(SeplosBmsTelemetryTest, TotalVoltage) {
   sensor::Sensor total;
   bms.set_total_voltage_sensor(&total);
 
-  bms.on_seplos_modbus_data(TELEMETRY_FRAME);
+  bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
 
   EXPECT_NEAR(total.state, 52.80f, 0.01f);
 }
@@ -99,7 +99,7 @@ TEST(SeplosBmsTelemetryTest, Capacity) {
   bms.set_battery_capacity_sensor(&battery);
   bms.set_rated_capacity_sensor(&rated);
 
-  bms.on_seplos_modbus_data(TELEMETRY_FRAME);
+  bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
 
   EXPECT_NEAR(residual.state, 133.90f, 0.01f);
   EXPECT_NEAR(battery.state, 170.00f, 0.01f);
@@ -115,7 +115,7 @@ TEST(SeplosBmsTelemetryTest, StateOfChargeAndHealth) {
   bms.set_state_of_health_sensor(&soh);
   bms.set_charging_cycles_sensor(&cycles);
 
-  bms.on_seplos_modbus_data(TELEMETRY_FRAME);
+  bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
 
   EXPECT_NEAR(soc.state, 78.7f, 0.1f);
   EXPECT_NEAR(soh.state, 100.0f, 0.1f);
@@ -129,7 +129,7 @@ TEST(SeplosBmsTelemetryTest, PortVoltage) {
   sensor::Sensor port;
   bms.set_port_voltage_sensor(&port);
 
-  bms.on_seplos_modbus_data(TELEMETRY_FRAME);
+  bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
 
   EXPECT_NEAR(port.state, 52.79f, 0.01f);
 }
@@ -141,17 +141,237 @@ TEST(SeplosBmsTelemetryTest, OnlineStatus) {
   binary_sensor::BinarySensor online;
   bms.set_online_status_binary_sensor(&online);
 
-  bms.on_seplos_modbus_data(TELEMETRY_FRAME);
+  bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
 
   EXPECT_TRUE(online.state);
 }
 
+// ── Alarms ───────────────────────────────────────────────────────────────────
+
+TEST(SeplosBmsAlarmTest, NoAlarms) {
+  TestableSeplosBms bms;
+  sensor::Sensor cell_alarms, temperature_alarms, event2;
+  binary_sensor::BinarySensor voltage_protection, current_protection;
+  text_sensor::TextSensor errors;
+  bms.set_cell_voltage_alarm_bitmask_sensor(&cell_alarms);
+  bms.set_temperature_alarm_bitmask_sensor(&temperature_alarms);
+  bms.set_alarm_event2_bitmask_sensor(&event2);
+  bms.set_voltage_protection_binary_sensor(&voltage_protection);
+  bms.set_current_protection_binary_sensor(&current_protection);
+  bms.set_errors_text_sensor(&errors);
+
+  bms.on_seplos_modbus_data(0x44, ALARM_FRAME.data(), ALARM_FRAME.size());
+
+  EXPECT_FLOAT_EQ(cell_alarms.state, 0.0f);
+  EXPECT_FLOAT_EQ(temperature_alarms.state, 0.0f);
+  EXPECT_FLOAT_EQ(event2.state, 0.0f);
+  EXPECT_FALSE(voltage_protection.state);
+  EXPECT_FALSE(current_protection.state);
+  EXPECT_EQ(errors.state, "No alarms");
+}
+
+TEST(SeplosBmsAlarmTest, ActiveAlarms) {
+  TestableSeplosBms bms;
+  sensor::Sensor cell_alarms, temperature_alarms, event2, event5;
+  binary_sensor::BinarySensor voltage_protection, current_protection;
+  text_sensor::TextSensor errors;
+  bms.set_cell_voltage_alarm_bitmask_sensor(&cell_alarms);
+  bms.set_temperature_alarm_bitmask_sensor(&temperature_alarms);
+  bms.set_alarm_event2_bitmask_sensor(&event2);
+  bms.set_alarm_event5_bitmask_sensor(&event5);
+  bms.set_voltage_protection_binary_sensor(&voltage_protection);
+  bms.set_current_protection_binary_sensor(&current_protection);
+  bms.set_errors_text_sensor(&errors);
+
+  bms.on_seplos_modbus_data(0x44, ALARM_FRAME_WITH_ALARMS.data(), ALARM_FRAME_WITH_ALARMS.size());
+
+  EXPECT_FLOAT_EQ(cell_alarms.state, 4.0f);
+  EXPECT_FLOAT_EQ(temperature_alarms.state, 2.0f);
+  EXPECT_FLOAT_EQ(event2.state, 2.0f);
+  EXPECT_FLOAT_EQ(event5.state, 1.0f);
+  EXPECT_TRUE(voltage_protection.state);
+  EXPECT_FALSE(current_protection.state);
+  EXPECT_EQ(errors.state,
+            "Cell 3 voltage above upper limit;Temperature 2 below lower limit;Single overvoltage protection;"
+            "Charging overcurrent alarm");
+}
+
+TEST(SeplosBmsAlarmTest, AlarmFrameDoesNotTouchTelemetry) {
+  TestableSeplosBms bms;
+  sensor::Sensor total_voltage;
+  bms.set_total_voltage_sensor(&total_voltage);
+
+  bms.on_seplos_modbus_data(0x44, ALARM_FRAME.data(), ALARM_FRAME.size());
+
+  EXPECT_FALSE(total_voltage.has_state());
+}
+
+TEST(SeplosBmsAlarmTest, ErrorsAreRebuiltOnlyWhenAnAlarmStateChanges) {
+  TestableSeplosBms bms;
+  text_sensor::TextSensor errors;
+  bms.set_errors_text_sensor(&errors);
+
+  // A republished text would overwrite the marker
+  bms.on_seplos_modbus_data(0x44, ALARM_FRAME.data(), ALARM_FRAME.size());
+  errors.state = "unchanged";
+  bms.on_seplos_modbus_data(0x44, ALARM_FRAME.data(), ALARM_FRAME.size());
+  EXPECT_EQ(errors.state, "unchanged");
+
+  bms.on_seplos_modbus_data(0x44, ALARM_FRAME_WITH_ALARMS.data(), ALARM_FRAME_WITH_ALARMS.size());
+  EXPECT_NE(errors.state, "unchanged");
+
+  bms.on_seplos_modbus_data(0x44, ALARM_FRAME.data(), ALARM_FRAME.size());
+  EXPECT_EQ(errors.state, "No alarms");
+}
+
+TEST(SeplosBmsAlarmTest, LateAlarmFrameIsNotDecodedAsTelemetry) {
+  TestableSeplosBms bms;
+  sensor::Sensor total_voltage, cell_voltage, cell_alarms;
+  bms.set_total_voltage_sensor(&total_voltage);
+  bms.set_cell_voltage_sensor(0, &cell_voltage);
+  bms.set_cell_voltage_alarm_bitmask_sensor(&cell_alarms);
+
+  // Answered after the response timeout: the bus no longer knows the request
+  bms.on_seplos_modbus_data(0x00, ALARM_FRAME_WITH_ALARMS.data(), ALARM_FRAME_WITH_ALARMS.size());
+
+  EXPECT_FALSE(total_voltage.has_state());
+  EXPECT_FALSE(cell_voltage.has_state());
+  EXPECT_FALSE(cell_alarms.has_state());
+}
+
+TEST(SeplosBmsAlarmTest, TruncatedAlarmFrameDoesNotCrash) {
+  TestableSeplosBms bms;
+  text_sensor::TextSensor errors;
+  bms.set_errors_text_sensor(&errors);
+
+  for (size_t len = 6; len < ALARM_FRAME.size(); len++) {
+    EXPECT_NO_FATAL_FAILURE(bms.on_seplos_modbus_data(0x44, ALARM_FRAME.data(), len));
+  }
+}
+
+// ── All-packs telemetry ───────────────────────────────────────────────────────
+
+TEST(SeplosBmsAllPacksTest, RecordsAreFannedOutToPacks) {
+  TestableSeplosBms master, pack2;
+  sensor::Sensor master_voltage, master_cycles, pack2_voltage, pack2_cycles;
+  master.set_pack(0x01);
+  master.set_total_voltage_sensor(&master_voltage);
+  master.set_charging_cycles_sensor(&master_cycles);
+  pack2.set_pack(0x02);
+  pack2.set_all_packs_source(&master);
+  pack2.set_total_voltage_sensor(&pack2_voltage);
+  pack2.set_charging_cycles_sensor(&pack2_cycles);
+
+  master.on_seplos_modbus_data(0x42, ALL_PACKS_TELEMETRY_FRAME.data(), ALL_PACKS_TELEMETRY_FRAME.size());
+
+  EXPECT_NEAR(master_voltage.state, 26.40f, 0.001f);
+  EXPECT_FLOAT_EQ(master_cycles.state, 10.0f);
+  EXPECT_NEAR(pack2_voltage.state, 26.00f, 0.001f);
+  EXPECT_FLOAT_EQ(pack2_cycles.state, 20.0f);
+}
+
+TEST(SeplosBmsAllPacksTest, PackIgnoresBusFrames) {
+  TestableSeplosBms master, pack2;
+  sensor::Sensor pack2_voltage;
+  pack2.set_all_packs_source(&master);
+  pack2.set_total_voltage_sensor(&pack2_voltage);
+
+  pack2.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size());
+
+  EXPECT_FALSE(pack2_voltage.has_state());
+}
+
+TEST(SeplosBmsAllPacksTest, PackDecodesItsOwnAlarms) {
+  TestableSeplosBms master, pack2;
+  sensor::Sensor master_cell_alarms, pack2_cell_alarms;
+  master.set_cell_voltage_alarm_bitmask_sensor(&master_cell_alarms);
+  pack2.set_all_packs_source(&master);
+  pack2.set_cell_voltage_alarm_bitmask_sensor(&pack2_cell_alarms);
+
+  pack2.on_seplos_modbus_data(0x44, ALARM_FRAME_WITH_ALARMS.data(), ALARM_FRAME_WITH_ALARMS.size());
+
+  EXPECT_FLOAT_EQ(pack2_cell_alarms.state, 4.0f);
+  EXPECT_FALSE(master_cell_alarms.has_state());
+}
+
+TEST(SeplosBmsAllPacksTest, PackDecodesItsOwnDeviceInformation) {
+  TestableSeplosBms master, pack2;
+  text_sensor::TextSensor protocol_version;
+  pack2.set_all_packs_source(&master);
+  pack2.set_protocol_version_text_sensor(&protocol_version);
+
+  pack2.on_seplos_modbus_data(0x4F, PROTOCOL_VERSION_FRAME.data(), PROTOCOL_VERSION_FRAME.size());
+
+  EXPECT_EQ(protocol_version.state, "2.0");
+}
+
+TEST(SeplosBmsAllPacksTest, TruncatedFrameDoesNotCrash) {
+  TestableSeplosBms master, pack2;
+  sensor::Sensor pack2_voltage;
+  master.set_pack(0x00);
+  pack2.set_pack(0x01);
+  pack2.set_all_packs_source(&master);
+  pack2.set_total_voltage_sensor(&pack2_voltage);
+
+  for (size_t len = 44; len < ALL_PACKS_TELEMETRY_FRAME.size(); len++) {
+    EXPECT_NO_FATAL_FAILURE(master.on_seplos_modbus_data(0x42, ALL_PACKS_TELEMETRY_FRAME.data(), len));
+  }
+  EXPECT_FALSE(pack2_voltage.has_state());
+}
+
+// ── Static device information ─────────────────────────────────────────────────
+
+TEST(SeplosBmsDeviceInfoTest, ProtocolVersion) {
+  TestableSeplosBms bms;
+  text_sensor::TextSensor protocol_version;
+  bms.set_protocol_version_text_sensor(&protocol_version);
+
+  bms.on_seplos_modbus_data(0x4F, PROTOCOL_VERSION_FRAME.data(), PROTOCOL_VERSION_FRAME.size());
+
+  EXPECT_EQ(protocol_version.state, "2.0");
+}
+
+TEST(SeplosBmsDeviceInfoTest, ManufacturerInfo) {
+  TestableSeplosBms bms;
+  text_sensor::TextSensor device_model, software_version, manufacturer;
+  bms.set_device_model_text_sensor(&device_model);
+  bms.set_software_version_text_sensor(&software_version);
+  bms.set_manufacturer_text_sensor(&manufacturer);
+
+  bms.on_seplos_modbus_data(0x51, MANUFACTURER_INFO_FRAME.data(), MANUFACTURER_INFO_FRAME.size());
+
+  EXPECT_EQ(device_model.state, "1101-ZH26");
+  EXPECT_EQ(software_version.state, "2.6");
+  EXPECT_TRUE(manufacturer.has_state());
+  EXPECT_EQ(manufacturer.state, "");
+}
+
+TEST(SeplosBmsDeviceInfoTest, TruncatedManufacturerInfoIsIgnored) {
+  TestableSeplosBms bms;
+  text_sensor::TextSensor device_model;
+  bms.set_device_model_text_sensor(&device_model);
+
+  bms.on_seplos_modbus_data(0x51, MANUFACTURER_INFO_FRAME.data(), MANUFACTURER_INFO_FRAME.size() - 1);
+
+  EXPECT_FALSE(device_model.has_state());
+}
+
+TEST(SeplosBmsDeviceInfoTest, RejectedRequestIsNotDecoded) {
+  TestableSeplosBms bms;
+  text_sensor::TextSensor protocol_version;
+  bms.set_protocol_version_text_sensor(&protocol_version);
+
+  bms.on_seplos_modbus_data(0x4F, REJECTED_FRAME.data(), REJECTED_FRAME.size());
+
+  EXPECT_FALSE(protocol_version.has_state());
+}
+
 // ── Null sensors do not crash ─────────────────────────────────────────────────
 
 TEST(SeplosBmsSafetyTest, NullSensorsDoNotCrash) {
   TestableSeplosBms bms;
 
-  EXPECT_NO_FATAL_FAILURE(bms.on_seplos_modbus_data(TELEMETRY_FRAME));
+  EXPECT_NO_FATAL_FAILURE(bms.on_seplos_modbus_data(0x42, TELEMETRY_FRAME.data(), TELEMETRY_FRAME.size()));
 }
 
 }  // namespace esphome::seplos_bms::testing
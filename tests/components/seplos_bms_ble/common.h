@@ -1,13 +1,48 @@
 #pragma once
+#include <vector>
 #include "esphome/components/seplos_bms_ble/seplos_bms_ble.h"
 #include "esphome/components/switch/switch.h"
 
 namespace esphome::seplos_bms_ble::testing {
 
+inline uint16_t crc_xmodem(const uint8_t *data, size_t len) {
+  uint16_t crc = 0x0000;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t) data[i] << 8;
+    for (uint8_t j = 0; j < 8; j++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+// Patches the length field and appends CRC and end of frame to a recorded frame
+inline std::vector<uint8_t> seal_frame(const std::vector<uint8_t> &frame) {
+  std::vector<uint8_t> sealed(frame);
+  const uint16_t data_len = sealed.size() - 7;
+  sealed[5] = data_len >> 8;
+  sealed[6] = data_len & 0xFF;
+  const uint16_t crc = crc_xmodem(sealed.data() + 1, sealed.size() - 1);
+  sealed.push_back(crc >> 8);
+  sealed.push_back(crc & 0xFF);
+  sealed.push_back(0x0D);
+  return sealed;
+}
+
 class TestableSeplosBmsBle : public SeplosBmsBle {
  public:
+  using SeplosBmsBle::check_command_timeout_;
+  using SeplosBmsBle::next_command_;
+  using SeplosBmsBle::on_mtu_negotiated_;
+  using SeplosBmsBle::start_poll_cycle_;
+  using SeplosBmsBle::waiting_for_response_;
+
+  std::vector<uint8_t> sent_commands;
+
   void update() override {}
-  bool send_command(uint8_t function, const std::vector<uint8_t> &payload = {}) { return false; }
+  bool send_command(uint8_t function, const std::vector<uint8_t> &payload = {}) override {
+    sent_commands.push_back(function);
+    return false;
+  }
 };
 
 class TestableSwitch : public switch_::Switch {
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -146,4 +147,172 @@ static const std::vector<uint8_t> SINGLE_MACHINE_FRAME = {
     0x00,
 };
 
+// Position of alarm event 1 in SINGLE_MACHINE_FRAME
+static const size_t SINGLE_MACHINE_FRAME_ALARM_EVENTS = 71;
+
+// Settings frame (function 0x47), 145 bytes without CRC and end of frame
+// Decoded key values:
+//   cell_high_voltage_alarm=3.550V  cell_overvoltage_protection=3.650V
+//   total_overvoltage_protection=58.40V  charging_high_temperature_alarm=50.05°C
+//   charging_overcurrent_protection=160.00A  rated_capacity=200.00Ah
+//   cells_in_series=16  function_switch_7=0x03 (charge balancing, static equalization)
+static const std::vector<uint8_t> SETTINGS_FRAME = {
+    // header (7 bytes)
+    0x7E,
+    0x10,
+    0x00,
+    0x47,
+    0x00,
+    0x00,
+    0x00,
+    // group, parameter count
+    0x01,
+    0x46,
+    // cell voltage thresholds (10 x 2 bytes, 1 mV)
+    0x0D,
+    0xDE,
+    0x0D,
+    0x7A,
+    0x0A,
+    0xF0,
+    0x0B,
+    0xB8,
+    0x0E,
+    0x42,
+    0x0D,
+    0x48,
+    0x0A,
+    0x8C,
+    0x0B,
+    0x54,
+    0x0D,
+    0x48,
+    0x09,
+    0xC4,
+    // total voltage thresholds (10 x 2 bytes, 10 mV)
+    0x16,
+    0x30,
+    0x15,
+    0x90,
+    0x11,
+    0x80,
+    0x12,
+    0xC0,
+    0x16,
+    0xD0,
+    0x15,
+    0x40,
+    0x10,
+    0xE0,
+    0x12,
+    0x20,
+    0x16,
+    0xD0,
+    0x15,
+    0x40,
+    // temperature thresholds (30 x 2 bytes, 0.1 K)
+    0x0C,
+    0xA0,
+    0x0C,
+    0x82,
+    0x0A,
+    0xC0,
+    0x0A,
+    0xDE,
+    0x0C,
+    0xD2,
+    0x0C,
+    0xA0,
+    0x0A,
+    0xAC,
+    0x0A,
+    0xCA,
+    0x0C,
+    0xB4,
+    0x0C,
+    0x96,
+    0x0A,
+    0x16,
+    0x0A,
+    0x34,
+    0x0D,
+    0x04,
+    0x0C,
+    0xD2,
+    0x09,
+    0xE4,
+    0x0A,
+    0x02,
+    0x0A,
+    0xAC,
+    0x0A,
+    0xDE,
+    0x0D,
+    0x04,
+    0x0C,
+    0xD2,
+    0x0A,
+    0x16,
+    0x0A,
+    0x34,
+    0x0D,
+    0x36,
+    0x0D,
+    0x04,
+    0x09,
+    0xE4,
+    0x0A,
+    0x02,
+    0x0E,
+    0x30,
+    0x0D,
+    0xFE,
+    0x0E,
+    0x94,
+    0x0E,
+    0x62,
+    // current thresholds (7 x 2 bytes, 10 mA)
+    0x3A,
+    0x98,
+    0x36,
+    0xB0,
+    0x3A,
+    0x98,
+    0x36,
+    0xB0,
+    0x3E,
+    0x80,
+    0x3E,
+    0x80,
+    0x75,
+    0x30,
+    // soft start delay, rated capacity, remaining capacity (3 x 2 bytes)
+    0x01,
+    0xF4,
+    0x4E,
+    0x20,
+    0x27,
+    0x10,
+    // reserved
+    0x00,
+    // 1-byte parameters
+    0x32,
+    0x28,
+    0x1E,
+    0x0A,
+    0x08,
+    0x10,
+    // function switches 1-8
+    0xFF,
+    0xFF,
+    0xFF,
+    0x7F,
+    0xFF,
+    0xFF,
+    0x03,
+    0x3F,
+    // reserved
+    0x00,
+};
+
 }  // namespace esphome::seplos_bms_ble::testing
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "../allocation.h"
+#include "common.h"
+#include "frames.h"
+
+namespace esphome::seplos_bms_ble::testing {
+
+// Allowed heap allocations per poll cycle (single machine data)
+static const size_t POLL_CYCLE_ALLOCATION_BUDGET = 0;
+
+TEST(SeplosBmsBleAllocationTest, PollCycle) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor cells[8], total_voltage, current;
+  text_sensor::TextSensor alarms;
+  for (int i = 0; i < 8; i++)
+    bms.set_cell_voltage_sensor(i, &cells[i]);
+  bms.set_total_voltage_sensor(&total_voltage);
+  bms.set_current_sensor(&current);
+  bms.set_alarms_text_sensor(&alarms);
+  const std::vector<uint8_t> frame = seal_frame(SINGLE_MACHINE_FRAME);
+
+  // Notifications of 20 bytes
+  EXPECT_TRUE(allocation::within_budget("SeplosBmsBle poll cycle", POLL_CYCLE_ALLOCATION_BUDGET, [&]() {
+    for (size_t pos = 0; pos < frame.size(); pos += 20)
+      bms.assemble(frame.data() + pos, std::min<size_t>(20, frame.size() - pos));
+  }));
+  EXPECT_NEAR(total_voltage.state, 48.00f, 0.01f);
+}
+
+TEST(SeplosBmsBleAllocationTest, AssemblerDoesNotAllocate) {
+  TestableSeplosBmsBle bms;
+  // A corrupted CRC stops the frame right before decode()
+  std::vector<uint8_t> frame = seal_frame(SINGLE_MACHINE_FRAME);
+  frame[frame.size() - 2] ^= 0xFF;
+
+  EXPECT_TRUE(allocation::within_budget("SeplosBmsBle assembler", 0, [&]() {
+    for (size_t pos = 0; pos < frame.size(); pos += 20)
+      bms.assemble(frame.data() + pos, std::min<size_t>(20, frame.size() - pos));
+  }));
+}
+
+TEST(SeplosBmsBleAllocationTest, UnchangedSettingsDoNotAllocate) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor cell_high_voltage_alarm;
+  bms.set_setting_sensor(0, &cell_high_voltage_alarm);
+  bms.decode(SETTINGS_FRAME);
+
+  EXPECT_TRUE(allocation::within_budget("SeplosBmsBle unchanged settings", 0, [&]() { bms.decode(SETTINGS_FRAME); }));
+}
+
+}  // namespace esphome::seplos_bms_ble::testing
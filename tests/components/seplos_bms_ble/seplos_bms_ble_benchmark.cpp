@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "../benchmark.h"
+#include "common.h"
+#include "frames.h"
+
+namespace esphome::seplos_bms_ble::testing {
+
+// BLE notifications carry up to 20 bytes with the default ATT MTU
+static const size_t NOTIFICATION_SIZE = 20;
+
+static void configure_sensors(TestableSeplosBmsBle &bms, sensor::Sensor *cells, sensor::Sensor &total_voltage,
+                              sensor::Sensor &current, text_sensor::TextSensor &alarms) {
+  for (int i = 0; i < 8; i++)
+    bms.set_cell_voltage_sensor(i, &cells[i]);
+  bms.set_total_voltage_sensor(&total_voltage);
+  bms.set_current_sensor(&current);
+  bms.set_alarms_text_sensor(&alarms);
+}
+
+TEST(SeplosBmsBleBenchmark, AssembleSingleMachineFrame) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor cells[8], total_voltage, current;
+  text_sensor::TextSensor alarms;
+  configure_sensors(bms, cells, total_voltage, current, alarms);
+  const std::vector<uint8_t> frame = seal_frame(SINGLE_MACHINE_FRAME);
+
+  auto result = benchmark::run("SeplosBmsBle::assemble", frame.size(), [&]() {
+    for (size_t pos = 0; pos < frame.size(); pos += NOTIFICATION_SIZE)
+      bms.assemble(frame.data() + pos, std::min(NOTIFICATION_SIZE, frame.size() - pos));
+  });
+
+  EXPECT_GT(result.iterations, 0u);
+  EXPECT_NEAR(total_voltage.state, 48.00f, 0.01f);
+}
+
+TEST(SeplosBmsBleBenchmark, DecodeSingleMachineFrame) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor cells[8], total_voltage, current;
+  text_sensor::TextSensor alarms;
+  configure_sensors(bms, cells, total_voltage, current, alarms);
+
+  auto result = benchmark::run("SeplosBmsBle::decode", SINGLE_MACHINE_FRAME.size(),
+                               [&]() { bms.decode(SINGLE_MACHINE_FRAME); });
+
+  EXPECT_GT(result.iterations, 0u);
+  EXPECT_NEAR(total_voltage.state, 48.00f, 0.01f);
+}
+
+}  // namespace esphome::seplos_bms_ble::testing
@@ -1,4 +1,8 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
 #include "common.h"
 #include "frames.h"
 
@@ -206,12 +210,384 @@ TEST(SeplosBmsBleStatusTest, ConsolidatedAlarms) {
   EXPECT_EQ(alarms.state, "No alarms");
 }
 
+static std::vector<uint8_t> with_alarm_events(uint8_t event, uint8_t mask) {
+  std::vector<uint8_t> frame(SINGLE_MACHINE_FRAME);
+  frame[SINGLE_MACHINE_FRAME_ALARM_EVENTS + event] = mask;
+  return frame;
+}
+
+TEST(SeplosBmsBleStatusTest, ConsolidatedAlarmsListActiveAlarms) {
+  TestableSeplosBmsBle bms;
+  text_sensor::TextSensor alarms;
+  sensor::Sensor ev1;
+  bms.set_alarms_text_sensor(&alarms);
+  bms.set_alarm_event1_bitmask_sensor(&ev1);
+
+  std::vector<uint8_t> frame = with_alarm_events(0, 0x03);
+  frame[SINGLE_MACHINE_FRAME_ALARM_EVENTS + 4] = 0x02;
+  bms.decode(frame);
+
+  EXPECT_EQ(alarms.state, "Voltage sensing failure;Temperature sensing failure;Charging overcurrent protection");
+  EXPECT_FLOAT_EQ(ev1.state, 3.0f);
+}
+
+TEST(SeplosBmsBleStatusTest, UnchangedAlarmsAreNotRepublished) {
+  TestableSeplosBmsBle bms;
+  text_sensor::TextSensor alarms;
+  sensor::Sensor ev1;
+  bms.set_alarms_text_sensor(&alarms);
+  bms.set_alarm_event1_bitmask_sensor(&ev1);
+
+  bms.decode(with_alarm_events(0, 0x01));
+  alarms.state = "";
+  ev1.state = NAN;
+  bms.decode(with_alarm_events(0, 0x01));
+
+  EXPECT_EQ(alarms.state, "");
+  EXPECT_TRUE(std::isnan(ev1.state));
+
+  bms.decode(SINGLE_MACHINE_FRAME);
+
+  EXPECT_EQ(alarms.state, "No alarms");
+  EXPECT_FLOAT_EQ(ev1.state, 0.0f);
+}
+
+TEST(SeplosBmsBleStatusTest, AlarmCallbackReportsSetAndClearedAlarms) {
+  TestableSeplosBmsBle bms;
+  std::vector<std::pair<uint8_t, bool>> changes;
+  std::string last_message;
+  bms.add_on_alarm_callback([&](uint8_t alarm, bool active, const char *message) {
+    changes.emplace_back(alarm, active);
+    last_message = message;
+  });
+
+  bms.decode(SINGLE_MACHINE_FRAME);
+  EXPECT_TRUE(changes.empty());
+
+  // Alarm event 2, bit 1: single overvoltage protection
+  bms.decode(with_alarm_events(1, 0x02));
+  bms.decode(with_alarm_events(1, 0x02));
+  ASSERT_EQ(changes.size(), 1u);
+  EXPECT_EQ(changes[0], std::make_pair(uint8_t(9), true));
+  EXPECT_EQ(last_message, "Single overvoltage protection");
+
+  bms.decode(SINGLE_MACHINE_FRAME);
+  ASSERT_EQ(changes.size(), 2u);
+  EXPECT_EQ(changes[1], std::make_pair(uint8_t(9), false));
+}
+
+// ── Frame assembly ────────────────────────────────────────────────────────────
+
+TEST(SeplosBmsBleAssembleTest, ChunkedFrameIsDecoded) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor total_voltage;
+  bms.set_total_voltage_sensor(&total_voltage);
+  const std::vector<uint8_t> frame = seal_frame(SINGLE_MACHINE_FRAME);
+
+  for (size_t pos = 0; pos < frame.size(); pos += 20)
+    bms.assemble(frame.data() + pos, std::min<size_t>(20, frame.size() - pos));
+
+  EXPECT_NEAR(total_voltage.state, 48.00f, 0.01f);
+}
+
+TEST(SeplosBmsBleAssembleTest, FrameWithInvalidCrcIsDropped) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor total_voltage;
+  bms.set_total_voltage_sensor(&total_voltage);
+  std::vector<uint8_t> frame = seal_frame(SINGLE_MACHINE_FRAME);
+  frame[frame.size() - 2] ^= 0xFF;
+
+  bms.assemble(frame.data(), frame.size());
+
+  EXPECT_FALSE(total_voltage.has_state());
+}
+
+TEST(SeplosBmsBleAssembleTest, ChunkedFrameWithInvalidCrcIsDropped) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor total_voltage;
+  bms.set_total_voltage_sensor(&total_voltage);
+  const std::vector<uint8_t> frame = seal_frame(SINGLE_MACHINE_FRAME);
+  std::vector<uint8_t> corrupted = frame;
+  corrupted[30] ^= 0x01;
+
+  // The CRC is hashed chunk by chunk, the header is split across the first chunks
+  for (size_t pos = 0; pos < corrupted.size(); pos += 5)
+    bms.assemble(corrupted.data() + pos, std::min<size_t>(5, corrupted.size() - pos));
+  EXPECT_FALSE(total_voltage.has_state());
+
+  for (size_t pos = 0; pos < frame.size(); pos += 5)
+    bms.assemble(frame.data() + pos, std::min<size_t>(5, frame.size() - pos));
+  EXPECT_NEAR(total_voltage.state, 48.00f, 0.01f);
+}
+
+TEST(SeplosBmsBleAssembleTest, OversizedInputIsDroppedAndNextFrameDecoded) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor total_voltage;
+  bms.set_total_voltage_sensor(&total_voltage);
+  const std::vector<uint8_t> garbage(MAX_RESPONSE_SIZE + 1, 0x55);
+  const std::vector<uint8_t> frame = seal_frame(SINGLE_MACHINE_FRAME);
+
+  bms.assemble(garbage.data(), garbage.size());
+  EXPECT_FALSE(total_voltage.has_state());
+
+  bms.assemble(frame.data(), frame.size());
+  EXPECT_NEAR(total_voltage.state, 48.00f, 0.01f);
+}
+
+TEST(SeplosBmsBleAssembleTest, FrameInOneNotificationIsDecoded) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor total_voltage;
+  bms.set_total_voltage_sensor(&total_voltage);
+  const std::vector<uint8_t> frame = seal_frame(SINGLE_MACHINE_FRAME);
+
+  bms.on_mtu_negotiated_(247);
+  bms.assemble(frame.data(), frame.size());
+  EXPECT_NEAR(total_voltage.state, 48.00f, 0.01f);
+
+  // A notification holding only a part of the frame is still reassembled
+  total_voltage.state = 0.0f;
+  bms.assemble(frame.data(), 50);
+  bms.assemble(frame.data() + 50, frame.size() - 50);
+  EXPECT_NEAR(total_voltage.state, 48.00f, 0.01f);
+}
+
+TEST(SeplosBmsBleAssembleTest, LargestMtuOfAllInstancesIsTheLocalMtu) {
+  TestableSeplosBmsBle first, second;
+
+  first.set_mtu(185);
+  second.set_mtu(100);
+
+  EXPECT_GE(seplos_ble::get_local_mtu(), 185);
+  EXPECT_NE(seplos_ble::get_local_mtu(), 100);
+}
+
+TEST(SeplosBmsBleAssembleTest, NegotiatedMtuIsRecorded) {
+  TestableSeplosBmsBle bms;
+  EXPECT_EQ(bms.get_mtu(), BLE_DEFAULT_MTU);
+
+  bms.on_mtu_negotiated_(247);
+  EXPECT_EQ(bms.get_mtu(), 247);
+}
+
+// ── Poll cycle ────────────────────────────────────────────────────────────────
+
+static const uint8_t GET_SINGLE_MACHINE_DATA = 0x61;
+static const uint8_t GET_PARALLEL_DATA = 0x62;
+static const uint16_t RESPONSE_TIMEOUT = 500;
+
+TEST(SeplosBmsBlePollCycleTest, LostResponseIsRetriedOnce) {
+  TestableSeplosBmsBle bms;
+  bms.start_poll_cycle_(0);
+  ASSERT_EQ(bms.sent_commands.size(), 1u);
+
+  bms.check_command_timeout_(RESPONSE_TIMEOUT - 1);
+  EXPECT_EQ(bms.sent_commands.size(), 1u);
+
+  bms.check_command_timeout_(RESPONSE_TIMEOUT);
+  ASSERT_EQ(bms.sent_commands.size(), 2u);
+  EXPECT_EQ(bms.sent_commands[1], bms.sent_commands[0]);
+  EXPECT_EQ(bms.get_command_stats(0).timeouts, 1u);
+  EXPECT_EQ(bms.get_command_stats(0).skipped, 0u);
+}
+
+TEST(SeplosBmsBlePollCycleTest, UnansweredCommandIsSkipped) {
+  TestableSeplosBmsBle bms;
+  bms.start_poll_cycle_(0);
+  bms.check_command_timeout_(RESPONSE_TIMEOUT);
+  bms.check_command_timeout_(2 * RESPONSE_TIMEOUT);
+
+  EXPECT_EQ(bms.next_command_, 1);
+  EXPECT_EQ(bms.get_command_stats(0).requests, 2u);
+  EXPECT_EQ(bms.get_command_stats(0).skipped, 1u);
+  EXPECT_EQ(bms.get_command_stats(1).requests, 1u);
+}
+
+TEST(SeplosBmsBlePollCycleTest, CycleCompletesWithoutAnyResponse) {
+  TestableSeplosBmsBle bms;
+  uint32_t now = 0;
+  bms.start_poll_cycle_(now);
+  while (bms.waiting_for_response_ && now < 100 * RESPONSE_TIMEOUT) {
+    now += RESPONSE_TIMEOUT;
+    bms.check_command_timeout_(now);
+  }
+
+  // Every command is sent twice (one retry) and the cycle ends in bounded time
+  EXPECT_FALSE(bms.waiting_for_response_);
+  EXPECT_EQ(bms.sent_commands.size(), 2u * SEPLOS_COMMAND_QUEUE_SIZE);
+  EXPECT_EQ(now, 2u * SEPLOS_COMMAND_QUEUE_SIZE * RESPONSE_TIMEOUT);
+}
+
+TEST(SeplosBmsBlePollCycleTest, ResponseSendsNextCommand) {
+  TestableSeplosBmsBle bms;
+  uint32_t now = 0;
+  bms.start_poll_cycle_(now);
+  while (bms.sent_commands.back() != GET_SINGLE_MACHINE_DATA) {
+    now += RESPONSE_TIMEOUT;
+    bms.check_command_timeout_(now);
+  }
+  const uint8_t index = bms.next_command_;
+
+  bms.decode(SINGLE_MACHINE_FRAME);
+
+  EXPECT_EQ(bms.sent_commands.back(), GET_PARALLEL_DATA);
+  EXPECT_EQ(bms.get_command_stats(index).responses, 1u);
+  EXPECT_EQ(bms.get_command_stats(index).skipped, 0u);
+}
+
+TEST(SeplosBmsBlePollCycleTest, UnrelatedResponseDoesNotAdvanceQueue) {
+  TestableSeplosBmsBle bms;
+  bms.start_poll_cycle_(0);
+  bms.decode(SINGLE_MACHINE_FRAME);
+  ASSERT_EQ(bms.sent_commands.back(), GET_PARALLEL_DATA);
+
+  bms.decode(SINGLE_MACHINE_FRAME);
+
+  EXPECT_EQ(bms.next_command_, 1);
+  EXPECT_TRUE(bms.waiting_for_response_);
+  EXPECT_EQ(bms.sent_commands.size(), 2u);
+}
+
+// ── Refresh policies ──────────────────────────────────────────────────────────
+
+static const uint8_t GET_SETTINGS = 0x47;
+static const uint8_t GET_MANUFACTURER_INFO = 0x51;
+
+// Answers every request of a poll cycle with an (empty) response of the requested function
+static std::vector<uint8_t> run_poll_cycle(TestableSeplosBmsBle &bms, uint8_t unanswered_function = 0x00) {
+  bms.sent_commands.clear();
+  uint32_t now = 0;
+  bms.start_poll_cycle_(now);
+  while (bms.waiting_for_response_ && bms.sent_commands.size() < 16) {
+    const uint8_t function = bms.sent_commands.back();
+    if (function == unanswered_function) {
+      now += RESPONSE_TIMEOUT;
+      bms.check_command_timeout_(now);
+      continue;
+    }
+    bms.decode(std::vector<uint8_t>{0x7E, 0x00, 0x00, function, 0x00, 0x00, 0x00});
+  }
+  return bms.sent_commands;
+}
+
+TEST(SeplosBmsBleRefreshTest, FirstCycleRequestsLiveDataFirst) {
+  TestableSeplosBmsBle bms;
+
+  EXPECT_EQ(run_poll_cycle(bms),
+            (std::vector<uint8_t>{GET_SINGLE_MACHINE_DATA, GET_PARALLEL_DATA, GET_SETTINGS, GET_MANUFACTURER_INFO}));
+}
+
+TEST(SeplosBmsBleRefreshTest, StaticDataIsNotRequestedAgain) {
+  TestableSeplosBmsBle bms;
+  run_poll_cycle(bms);
+
+  for (int cycle = 1; cycle < 10; cycle++) {
+    EXPECT_EQ(run_poll_cycle(bms), (std::vector<uint8_t>{GET_SINGLE_MACHINE_DATA, GET_PARALLEL_DATA}))
+        << "cycle " << cycle;
+  }
+}
+
+TEST(SeplosBmsBleRefreshTest, SettingsAreRefreshedPeriodically) {
+  TestableSeplosBmsBle bms;
+  size_t settings_requests = 0;
+  for (int cycle = 0; cycle <= 120; cycle++) {
+    const std::vector<uint8_t> sent = run_poll_cycle(bms);
+    settings_requests += std::count(sent.begin(), sent.end(), GET_SETTINGS);
+  }
+
+  // Cycles 0, 60 and 120
+  EXPECT_EQ(settings_requests, 3u);
+}
+
+TEST(SeplosBmsBleRefreshTest, UnansweredStaticCommandIsRequestedNextCycle) {
+  TestableSeplosBmsBle bms;
+  run_poll_cycle(bms, GET_MANUFACTURER_INFO);
+
+  EXPECT_EQ(run_poll_cycle(bms),
+            (std::vector<uint8_t>{GET_SINGLE_MACHINE_DATA, GET_PARALLEL_DATA, GET_MANUFACTURER_INFO}));
+  EXPECT_EQ(run_poll_cycle(bms), (std::vector<uint8_t>{GET_SINGLE_MACHINE_DATA, GET_PARALLEL_DATA}));
+}
+
+// ── Settings ──────────────────────────────────────────────────────────────────
+
+static const uint8_t SETTING_CELL_HIGH_VOLTAGE_ALARM = 0;
+static const uint8_t SETTING_TOTAL_OVERVOLTAGE_PROTECTION = 14;
+static const uint8_t SETTING_CHARGING_HIGH_TEMPERATURE_ALARM = 20;
+static const uint8_t SETTING_CHARGING_OVERCURRENT_PROTECTION = 54;
+static const uint8_t SETTING_RATED_CAPACITY = 58;
+static const uint8_t SETTING_CELLS_IN_SERIES = 65;
+
+TEST(SeplosBmsBleSettingsTest, SettingsArePublished) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor cell_high, total_ovp, charging_high_temp, charging_ocp, rated_capacity, cells_in_series;
+  bms.set_setting_sensor(SETTING_CELL_HIGH_VOLTAGE_ALARM, &cell_high);
+  bms.set_setting_sensor(SETTING_TOTAL_OVERVOLTAGE_PROTECTION, &total_ovp);
+  bms.set_setting_sensor(SETTING_CHARGING_HIGH_TEMPERATURE_ALARM, &charging_high_temp);
+  bms.set_setting_sensor(SETTING_CHARGING_OVERCURRENT_PROTECTION, &charging_ocp);
+  bms.set_setting_sensor(SETTING_RATED_CAPACITY, &rated_capacity);
+  bms.set_setting_sensor(SETTING_CELLS_IN_SERIES, &cells_in_series);
+
+  bms.decode(SETTINGS_FRAME);
+
+  EXPECT_NEAR(cell_high.state, 3.550f, 0.001f);
+  EXPECT_NEAR(total_ovp.state, 58.40f, 0.01f);
+  EXPECT_NEAR(charging_high_temp.state, 50.05f, 0.01f);
+  EXPECT_NEAR(charging_ocp.state, 160.00f, 0.01f);
+  EXPECT_NEAR(rated_capacity.state, 200.00f, 0.01f);
+  EXPECT_FLOAT_EQ(cells_in_series.state, 16.0f);
+}
+
+TEST(SeplosBmsBleSettingsTest, UnchangedSettingsAreNotRepublished) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor cell_high;
+  bms.set_setting_sensor(SETTING_CELL_HIGH_VOLTAGE_ALARM, &cell_high);
+
+  bms.decode(SETTINGS_FRAME);
+  ASSERT_NEAR(cell_high.state, 3.550f, 0.001f);
+
+  cell_high.state = NAN;
+  bms.decode(SETTINGS_FRAME);
+
+  EXPECT_TRUE(std::isnan(cell_high.state));
+}
+
+TEST(SeplosBmsBleSettingsTest, ChangedSettingIsPublished) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor cell_high, total_ovp;
+  bms.set_setting_sensor(SETTING_CELL_HIGH_VOLTAGE_ALARM, &cell_high);
+  bms.set_setting_sensor(SETTING_TOTAL_OVERVOLTAGE_PROTECTION, &total_ovp);
+
+  bms.decode(SETTINGS_FRAME);
+  cell_high.state = NAN;
+  total_ovp.state = NAN;
+
+  // Cell high voltage alarm 3.550 V -> 3.500 V
+  std::vector<uint8_t> changed(SETTINGS_FRAME);
+  changed[9] = 0x0D;
+  changed[10] = 0xAC;
+  bms.decode(changed);
+
+  EXPECT_NEAR(cell_high.state, 3.500f, 0.001f);
+  EXPECT_TRUE(std::isnan(total_ovp.state));
+}
+
+TEST(SeplosBmsBleSettingsTest, ShortSettingsFrameIsIgnored) {
+  TestableSeplosBmsBle bms;
+  sensor::Sensor cell_high;
+  bms.set_setting_sensor(SETTING_CELL_HIGH_VOLTAGE_ALARM, &cell_high);
+
+  std::vector<uint8_t> truncated(SETTINGS_FRAME.begin(), SETTINGS_FRAME.begin() + 100);
+  bms.decode(truncated);
+
+  EXPECT_FALSE(cell_high.has_state());
+}
+
 // ── Null sensors do not crash ─────────────────────────────────────────────────
 
 TEST(SeplosBmsBleSafetyTest, NullSensorsDoNotCrash) {
   TestableSeplosBmsBle bms;
 
   EXPECT_NO_FATAL_FAILURE(bms.decode(SINGLE_MACHINE_FRAME));
+  EXPECT_NO_FATAL_FAILURE(bms.decode(SETTINGS_FRAME));
 }
 
 }  // namespace esphome::seplos_bms_ble::testing
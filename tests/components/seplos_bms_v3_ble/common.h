@@ -3,8 +3,37 @@
 
 namespace esphome::seplos_bms_v3_ble::testing {
 
+// Register starts of the EMS info blocks
+static const uint16_t SEPLOS_V3_EIA_REG_START = 0x2000;
+static const uint16_t SEPLOS_V3_EIB_REG_START = 0x2100;
+static const uint16_t SEPLOS_V3_EIC_REG_START = 0x2200;
+
+inline uint16_t crc16_modbus(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (uint8_t j = 0; j < 8; j++)
+      crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+  }
+  return crc;
+}
+
 class TestableSeplosBmsV3Ble : public SeplosBmsV3Ble {
  public:
+  using SeplosBmsV3Ble::build_dynamic_command_queue_;
+  using SeplosBmsV3Ble::command_received_;
+  using SeplosBmsV3Ble::check_command_timeout_;
+  using SeplosBmsV3Ble::dynamic_command_queue_;
+  using SeplosBmsV3Ble::expired_count_;
+  using SeplosBmsV3Ble::next_command_;
+  using SeplosBmsV3Ble::on_mtu_negotiated_;
+  using SeplosBmsV3Ble::pack_count_;
+  using SeplosBmsV3Ble::poll_cycle_;
+  using SeplosBmsV3Ble::polling_;
+  using SeplosBmsV3Ble::request_count_;
+  using SeplosBmsV3Ble::requests_;
+  using SeplosBmsV3Ble::start_poll_cycle_;
+
   void update() override {}
   void decode_eia(const std::vector<uint8_t> &data) { decode_eia_data_(data); }
   void decode_eib(const std::vector<uint8_t> &data) { decode_eib_data_(data); }
@@ -12,6 +41,38 @@ class TestableSeplosBmsV3Ble : public SeplosBmsV3Ble {
   void decode_pct(const std::vector<uint8_t> &data) { decode_pct_data_(data); }
   void decode_spa1(const std::vector<uint8_t> &data) { decode_spa1_data_(data); }
   void decode_spa2(const std::vector<uint8_t> &data) { decode_spa2_data_(data); }
+
+  // Registers the request of the system block at reg_start as if the poll cycle had sent it
+  void expect_response(uint16_t reg_start) {
+    this->build_dynamic_command_queue_();
+    for (uint8_t i = 0; i < this->dynamic_command_queue_.size(); i++) {
+      if (this->dynamic_command_queue_[i].reg_start == reg_start) {
+        this->send_request_(i, 0, 0);
+        return;
+      }
+    }
+  }
+
+  // Answers the pending requests in order with zero filled responses of the expected size
+  void answer_pending_requests() {
+    while (this->request_count_ > 0) {
+      const SeplosV3Request request = this->requests_[0];
+      const std::vector<uint8_t> frame =
+          this->make_frame(std::vector<uint8_t>(request.byte_count, 0x00), request.device, request.function);
+      this->assemble(frame.data(), frame.size());
+    }
+  }
+
+  // Wraps a register payload into a Modbus-RTU response (device 0x00 and function 0x04 by default)
+  std::vector<uint8_t> make_frame(const std::vector<uint8_t> &payload, uint8_t device = 0x00,
+                                  uint8_t function = 0x04) {
+    std::vector<uint8_t> frame = {device, function, (uint8_t) payload.size()};
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    const uint16_t crc = crc16_modbus(frame.data(), frame.size());
+    frame.push_back(crc & 0xFF);
+    frame.push_back(crc >> 8);
+    return frame;
+  }
 };
 
 }  // namespace esphome::seplos_bms_v3_ble::testing
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "../allocation.h"
+#include "common.h"
+#include "frames.h"
+
+namespace esphome::seplos_bms_v3_ble::testing {
+
+// Allowed heap allocations per poll cycle (EIA, EIB and EIC)
+static const size_t POLL_CYCLE_ALLOCATION_BUDGET = 0;
+
+TEST(SeplosBmsV3BleAllocationTest, PollCycle) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor total_voltage, current, state_of_charge;
+  text_sensor::TextSensor problem;
+  bms.set_total_voltage_sensor(&total_voltage);
+  bms.set_current_sensor(&current);
+  bms.set_state_of_charge_sensor(&state_of_charge);
+  bms.set_problem_text_sensor(&problem);
+  const std::vector<uint8_t> eia = bms.make_frame(EIA_DATA);
+  const std::vector<uint8_t> eib = bms.make_frame(EIB_DATA);
+  const std::vector<uint8_t> eic = bms.make_frame(EIC_DATA_WITH_PROBLEM, 0x00, 0x01);
+  bms.build_dynamic_command_queue_();
+
+  auto feed = [&](const std::vector<uint8_t> &frame) {
+    for (size_t pos = 0; pos < frame.size(); pos += 20)
+      bms.assemble(frame.data() + pos, std::min<size_t>(20, frame.size() - pos));
+  };
+
+  EXPECT_TRUE(allocation::within_budget("SeplosBmsV3Ble poll cycle", POLL_CYCLE_ALLOCATION_BUDGET, [&]() {
+    bms.start_poll_cycle_(0);
+    feed(eia);
+    feed(eib);
+    feed(eic);
+  }));
+  EXPECT_NEAR(total_voltage.state, 52.80f, 0.01f);
+}
+
+TEST(SeplosBmsV3BleAllocationTest, AssemblerDoesNotAllocate) {
+  TestableSeplosBmsV3Ble bms;
+  // A corrupted CRC stops the frame right before decode()
+  std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+  frame.back() ^= 0xFF;
+
+  EXPECT_TRUE(allocation::within_budget("SeplosBmsV3Ble assembler", 0, [&]() {
+    for (size_t pos = 0; pos < frame.size(); pos += 20)
+      bms.assemble(frame.data() + pos, std::min<size_t>(20, frame.size() - pos));
+  }));
+}
+
+}  // namespace esphome::seplos_bms_v3_ble::testing
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "../benchmark.h"
+#include "common.h"
+#include "frames.h"
+
+namespace esphome::seplos_bms_v3_ble::testing {
+
+// BLE notifications carry up to 20 bytes with the default ATT MTU
+static const size_t NOTIFICATION_SIZE = 20;
+
+TEST(SeplosBmsV3BleBenchmark, AssembleEiaFrame) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor total_voltage, current, state_of_charge;
+  bms.set_total_voltage_sensor(&total_voltage);
+  bms.set_current_sensor(&current);
+  bms.set_state_of_charge_sensor(&state_of_charge);
+  const std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+
+  auto result = benchmark::run("SeplosBmsV3Ble::assemble", frame.size(), [&]() {
+    bms.expect_response(SEPLOS_V3_EIA_REG_START);
+    for (size_t pos = 0; pos < frame.size(); pos += NOTIFICATION_SIZE)
+      bms.assemble(frame.data() + pos, std::min(NOTIFICATION_SIZE, frame.size() - pos));
+  });
+
+  EXPECT_GT(result.iterations, 0u);
+  EXPECT_NEAR(total_voltage.state, 52.80f, 0.01f);
+}
+
+TEST(SeplosBmsV3BleBenchmark, DecodeEiaFrame) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor total_voltage, current, state_of_charge;
+  bms.set_total_voltage_sensor(&total_voltage);
+  bms.set_current_sensor(&current);
+  bms.set_state_of_charge_sensor(&state_of_charge);
+  const std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+
+  auto result = benchmark::run("SeplosBmsV3Ble::decode", frame.size(), [&]() {
+    bms.expect_response(SEPLOS_V3_EIA_REG_START);
+    bms.decode(frame);
+  });
+
+  EXPECT_GT(result.iterations, 0u);
+  EXPECT_NEAR(total_voltage.state, 52.80f, 0.01f);
+}
+
+}  // namespace esphome::seplos_bms_v3_ble::testing
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include "common.h"
 #include "frames.h"
 
@@ -543,6 +544,568 @@ TEST(SeplosBmsV3BleSpa2Test, NullSensorsDoNotCrash) {
   EXPECT_NO_FATAL_FAILURE(bms.decode_spa2(SPA_DATA_2));
 }
 
+// ── Frame assembly ────────────────────────────────────────────────────────────
+
+TEST(SeplosBmsV3BleAssembleTest, ChunkedFrameIsDecoded) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  const std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  for (size_t pos = 0; pos < frame.size(); pos += 20)
+    bms.assemble(frame.data() + pos, std::min<size_t>(20, frame.size() - pos));
+
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+}
+
+TEST(SeplosBmsV3BleAssembleTest, FrameWithInvalidCrcIsDropped) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+  frame.back() ^= 0xFF;
+
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  bms.assemble(frame.data(), frame.size());
+
+  EXPECT_FALSE(voltage.has_state());
+}
+
+TEST(SeplosBmsV3BleAssembleTest, OversizedInputIsDroppedAndNextFrameDecoded) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  const std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+
+  // Header announcing 0xFF bytes of data, followed by more than the buffer can hold
+  const std::vector<uint8_t> garbage = {0x00, 0x04, 0xFF};
+  bms.assemble(garbage.data(), garbage.size());
+  std::vector<uint8_t> filler(MAX_RESPONSE_SIZE, 0x55);
+  bms.assemble(filler.data(), filler.size());
+  EXPECT_FALSE(voltage.has_state());
+
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  bms.assemble(frame.data(), frame.size());
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+}
+
+TEST(SeplosBmsV3BleAssembleTest, FrameInOneNotificationIsDecoded) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  const std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+
+  bms.on_mtu_negotiated_(247);
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  bms.assemble(frame.data(), frame.size());
+
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+  EXPECT_EQ(bms.get_mtu(), 247);
+}
+
+TEST(SeplosBmsV3BleAssembleTest, FramesInOneNotificationAreAllDecoded) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage, max_cell_voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  bms.set_max_cell_voltage_sensor(&max_cell_voltage);
+  std::vector<uint8_t> data = bms.make_frame(EIA_DATA);
+  const std::vector<uint8_t> eib = bms.make_frame(EIB_DATA);
+  data.insert(data.end(), eib.begin(), eib.end());
+
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  bms.expect_response(SEPLOS_V3_EIB_REG_START);
+  bms.assemble(data.data(), data.size());
+
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+  EXPECT_NEAR(max_cell_voltage.state, 3.340f, 0.001f);
+  EXPECT_EQ(bms.request_count_, 0);
+}
+
+TEST(SeplosBmsV3BleAssembleTest, StartOfNextFrameIsKept) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage, max_cell_voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  bms.set_max_cell_voltage_sensor(&max_cell_voltage);
+  std::vector<uint8_t> data = bms.make_frame(EIA_DATA);
+  const std::vector<uint8_t> eib = bms.make_frame(EIB_DATA);
+  data.insert(data.end(), eib.begin(), eib.end());
+
+  // The notification with the end of EIA carries the start of EIB
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  bms.expect_response(SEPLOS_V3_EIB_REG_START);
+  for (size_t pos = 0; pos < data.size(); pos += 20)
+    bms.assemble(data.data() + pos, std::min<size_t>(20, data.size() - pos));
+
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+  EXPECT_NEAR(max_cell_voltage.state, 3.340f, 0.001f);
+}
+
+TEST(SeplosBmsV3BleAssembleTest, LeadingGarbageIsSkipped) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  std::vector<uint8_t> data = {0x55, 0xAA, 0x13, 0x00};
+  const std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+  data.insert(data.end(), frame.begin(), frame.end());
+
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  for (size_t pos = 0; pos < data.size(); pos += 20)
+    bms.assemble(data.data() + pos, std::min<size_t>(20, data.size() - pos));
+
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+}
+
+TEST(SeplosBmsV3BleAssembleTest, CorruptedLengthDoesNotBlockTheNextFrame) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage, baud_rate;
+  bms.set_total_voltage_sensor(&voltage);
+  bms.set_inverter_baud_rate_sensor(&baud_rate);
+  std::vector<uint8_t> data = bms.make_frame(EIA_DATA);
+  const std::vector<uint8_t> pct = bms.make_frame(PCT_DATA);
+  // EIA announces 240 bytes of data: more than both frames together
+  data[2] = 0xF0;
+  data.insert(data.end(), pct.begin(), pct.end());
+
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  bms.expect_response(0x1800);
+  for (size_t pos = 0; pos < data.size(); pos += 20)
+    bms.assemble(data.data() + pos, std::min<size_t>(20, data.size() - pos));
+
+  EXPECT_FALSE(voltage.has_state());
+  EXPECT_FLOAT_EQ(baud_rate.state, 500.0f);
+  EXPECT_EQ(bms.request_count_, 1);
+  EXPECT_EQ(bms.requests_[0].reg_start, SEPLOS_V3_EIA_REG_START);
+}
+
+// ── Poll cycle ────────────────────────────────────────────────────────────────
+
+static const uint16_t RESPONSE_TIMEOUT = 500;
+
+TEST(SeplosBmsV3BlePollCycleTest, ResponseSendsNextCommand) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  bms.build_dynamic_command_queue_();
+  const std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+
+  bms.start_poll_cycle_(0);
+  ASSERT_EQ(bms.request_count_, 1);
+  ASSERT_EQ(bms.requests_[0].reg_start, SEPLOS_V3_EIA_REG_START);
+  bms.assemble(frame.data(), frame.size());
+
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+  EXPECT_EQ(bms.next_command_, 2);
+  EXPECT_EQ(bms.request_count_, 1);
+  EXPECT_EQ(bms.requests_[0].reg_start, SEPLOS_V3_EIB_REG_START);
+  EXPECT_EQ(bms.get_command_stats(0).responses, 1u);
+}
+
+TEST(SeplosBmsV3BlePollCycleTest, RequestsOfTheSameSizeAreNotInFlightTogether) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage, max_cell_voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  bms.set_max_cell_voltage_sensor(&max_cell_voltage);
+  bms.set_max_requests_in_flight(3);
+  bms.build_dynamic_command_queue_();
+  const std::vector<uint8_t> eia = bms.make_frame(EIA_DATA);
+  const std::vector<uint8_t> eib = bms.make_frame(EIB_DATA);
+
+  // EIA and EIB are both 52 bytes long: EIB waits for the response of EIA
+  bms.start_poll_cycle_(0);
+  ASSERT_EQ(bms.request_count_, 1);
+  bms.assemble(eia.data(), eia.size());
+  ASSERT_GT(bms.request_count_, 1);
+  EXPECT_EQ(bms.requests_[0].reg_start, SEPLOS_V3_EIB_REG_START);
+  bms.assemble(eib.data(), eib.size());
+
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+  EXPECT_NEAR(max_cell_voltage.state, 3.340f, 0.001f);
+  EXPECT_EQ(bms.get_command_stats(0).responses, 1u);
+  EXPECT_EQ(bms.get_command_stats(1).responses, 1u);
+}
+
+TEST(SeplosBmsV3BlePollCycleTest, EibIsNotDecodedAsDroppedEia) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage, max_cell_voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  bms.set_max_cell_voltage_sensor(&max_cell_voltage);
+  bms.set_max_requests_in_flight(2);
+  bms.build_dynamic_command_queue_();
+  const std::vector<uint8_t> eib = bms.make_frame(EIB_DATA);
+
+  // EIA and its retry are lost: EIB is sent once a late EIA response cannot arrive anymore
+  bms.start_poll_cycle_(0);
+  bms.check_command_timeout_(RESPONSE_TIMEOUT);
+  bms.check_command_timeout_(2 * RESPONSE_TIMEOUT);
+  EXPECT_EQ(bms.get_command_stats(0).skipped, 1u);
+  EXPECT_EQ(bms.get_command_stats(1).requests, 0u);
+
+  bms.check_command_timeout_(3 * RESPONSE_TIMEOUT);
+  ASSERT_GE(bms.request_count_, 1);
+  ASSERT_EQ(bms.requests_[0].reg_start, SEPLOS_V3_EIB_REG_START);
+  bms.assemble(eib.data(), eib.size());
+
+  EXPECT_FALSE(voltage.has_state());
+  EXPECT_NEAR(max_cell_voltage.state, 3.340f, 0.001f);
+  EXPECT_EQ(bms.get_command_stats(1).responses, 1u);
+}
+
+TEST(SeplosBmsV3BlePollCycleTest, LateEiaResponseIsDecodedAsEia) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage, max_cell_voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  bms.set_max_cell_voltage_sensor(&max_cell_voltage);
+  bms.set_max_requests_in_flight(2);
+  bms.build_dynamic_command_queue_();
+  const std::vector<uint8_t> eia = bms.make_frame(EIA_DATA);
+  const std::vector<uint8_t> eib = bms.make_frame(EIB_DATA);
+
+  // The original EIA request and its retry are both answered
+  bms.start_poll_cycle_(0);
+  bms.check_command_timeout_(RESPONSE_TIMEOUT);
+  bms.assemble(eia.data(), eia.size());
+  EXPECT_EQ(bms.get_command_stats(0).responses, 1u);
+  EXPECT_EQ(bms.request_count_, 0);
+
+  bms.assemble(eia.data(), eia.size());
+  ASSERT_GE(bms.request_count_, 1);
+  ASSERT_EQ(bms.requests_[0].reg_start, SEPLOS_V3_EIB_REG_START);
+  EXPECT_FALSE(max_cell_voltage.has_state());
+
+  bms.assemble(eib.data(), eib.size());
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+  EXPECT_NEAR(max_cell_voltage.state, 3.340f, 0.001f);
+  EXPECT_EQ(bms.expired_count_, 0);
+}
+
+TEST(SeplosBmsV3BlePollCycleTest, LateResponseOfTheLastCycleIsNotDecodedAsEib) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage, max_cell_voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  bms.set_max_cell_voltage_sensor(&max_cell_voltage);
+  bms.build_dynamic_command_queue_();
+  const std::vector<uint8_t> eia = bms.make_frame(EIA_DATA);
+
+  // The next cycle starts while EIA is pending: its response arrives during the new cycle
+  bms.start_poll_cycle_(0);
+  bms.start_poll_cycle_(100);
+  ASSERT_EQ(bms.request_count_, 0);
+  bms.assemble(eia.data(), eia.size());
+
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+  EXPECT_FALSE(max_cell_voltage.has_state());
+  ASSERT_EQ(bms.request_count_, 1);
+  EXPECT_EQ(bms.requests_[0].reg_start, SEPLOS_V3_EIA_REG_START);
+}
+
+TEST(SeplosBmsV3BlePollCycleTest, UnrequestedSystemResponseIsDropped) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor voltage;
+  bms.set_total_voltage_sensor(&voltage);
+  bms.build_dynamic_command_queue_();
+  const std::vector<uint8_t> frame = bms.make_frame(EIA_DATA);
+
+  bms.assemble(frame.data(), frame.size());
+
+  EXPECT_FALSE(voltage.has_state());
+}
+
+// Records the byte count of the frames forwarded to a pack
+class RecordingPack : public SeplosBmsV3BlePack {
+ public:
+  void on_frame_data(ByteView frame) override { this->byte_counts.push_back(frame[2]); }
+  std::vector<uint8_t> byte_counts;
+};
+
+TEST(SeplosBmsV3BlePollCycleTest, PackResponsesAreMatchedByDeviceAndSize) {
+  TestableSeplosBmsV3Ble bms;
+  RecordingPack pack;
+  pack.set_address(0x01);
+  bms.register_pack_component(&pack);
+  bms.set_max_requests_in_flight(3);
+  bms.build_dynamic_command_queue_();
+  const size_t pia = 3;
+  ASSERT_EQ(bms.dynamic_command_queue_[pia].device, 0x01);
+
+  // Answer EIA, EIB and EIC: PIA, PIB and PIC are in flight
+  bms.start_poll_cycle_(0);
+  while (bms.request_count_ > 0 && bms.requests_[0].command < pia) {
+    const SeplosV3Request &request = bms.requests_[0];
+    const std::vector<uint8_t> frame =
+        bms.make_frame(std::vector<uint8_t>(request.byte_count, 0x00), request.device, request.function);
+    bms.assemble(frame.data(), frame.size());
+  }
+  ASSERT_EQ(bms.request_count_, 3);
+  ASSERT_EQ(bms.requests_[0].command, pia);
+
+  // PIB (26 registers) answers before PIA (17 registers)
+  const std::vector<uint8_t> pib = bms.make_frame(std::vector<uint8_t>(52, 0x00), 0x01, 0x04);
+  bms.assemble(pib.data(), pib.size());
+
+  ASSERT_EQ(pack.byte_counts.size(), 1u);
+  EXPECT_EQ(pack.byte_counts[0], 52);
+  EXPECT_EQ(bms.get_command_stats(pia).responses, 0u);
+  EXPECT_EQ(bms.get_command_stats(pia + 1).responses, 1u);
+  EXPECT_EQ(bms.requests_[0].command, pia);
+  EXPECT_EQ(bms.requests_[1].command, pia + 2);
+}
+
+TEST(SeplosBmsV3BlePollCycleTest, UnansweredCommandIsRetriedAndSkipped) {
+  TestableSeplosBmsV3Ble bms;
+  bms.build_dynamic_command_queue_();
+
+  bms.start_poll_cycle_(0);
+  bms.check_command_timeout_(RESPONSE_TIMEOUT);
+  EXPECT_EQ(bms.next_command_, 1);
+  EXPECT_EQ(bms.get_command_stats(0).requests, 2u);
+
+  // EIB has the size of EIA and waits until a late response of the retry cannot arrive anymore
+  bms.check_command_timeout_(2 * RESPONSE_TIMEOUT);
+  EXPECT_EQ(bms.get_command_stats(0).timeouts, 2u);
+  EXPECT_EQ(bms.get_command_stats(0).skipped, 1u);
+  EXPECT_EQ(bms.request_count_, 0);
+  EXPECT_TRUE(bms.polling_);
+
+  bms.check_command_timeout_(3 * RESPONSE_TIMEOUT);
+  ASSERT_EQ(bms.request_count_, 1);
+  EXPECT_EQ(bms.requests_[0].reg_start, SEPLOS_V3_EIB_REG_START);
+}
+
+TEST(SeplosBmsV3BlePollCycleTest, CycleCompletesWithoutAnyResponse) {
+  TestableSeplosBmsV3Ble bms;
+  bms.set_max_requests_in_flight(2);
+  bms.build_dynamic_command_queue_();
+  const size_t commands = bms.dynamic_command_queue_.size();
+
+  uint32_t now = 0;
+  bms.start_poll_cycle_(now);
+  while (bms.polling_ && now < 100 * RESPONSE_TIMEOUT) {
+    now += RESPONSE_TIMEOUT;
+    bms.check_command_timeout_(now);
+  }
+
+  // Every command is sent, retried and skipped
+  EXPECT_FALSE(bms.polling_);
+  for (size_t i = 0; i < commands; i++) {
+    EXPECT_EQ(bms.get_command_stats(i).requests, 2u) << "command " << i;
+    EXPECT_EQ(bms.get_command_stats(i).skipped, 1u) << "command " << i;
+  }
+}
+
+TEST(SeplosBmsV3BlePollCycleTest, SingleRequestInFlightIsSequential) {
+  TestableSeplosBmsV3Ble bms;
+  bms.build_dynamic_command_queue_();
+  const size_t commands = bms.dynamic_command_queue_.size();
+
+  bms.start_poll_cycle_(0);
+  EXPECT_EQ(bms.request_count_, 1);
+  for (size_t i = 0; i < commands; i++) {
+    ASSERT_EQ(bms.request_count_, 1);
+    const SeplosV3Request &request = bms.requests_[0];
+    EXPECT_EQ(request.command, i);
+    const std::vector<uint8_t> frame =
+        bms.make_frame(std::vector<uint8_t>(request.byte_count, 0x00), request.device, request.function);
+    bms.assemble(frame.data(), frame.size());
+  }
+
+  EXPECT_FALSE(bms.polling_);
+}
+
+// ── Command queue ─────────────────────────────────────────────────────────────
+
+static const uint16_t SEPLOS_V3_SPA1_REG_START = 0x1300;
+
+TEST(SeplosBmsV3BleCommandQueueTest, SpaIsReadAtOnceWithLargeMtu) {
+  TestableSeplosBmsV3Ble bms;
+  bms.build_dynamic_command_queue_();
+  const size_t commands = bms.dynamic_command_queue_.size();
+
+  // SPA (0x1300-0x1334 and 0x1335-0x1369) does not fit into a notification of the default MTU
+  EXPECT_EQ(bms.dynamic_command_queue_[commands - 2].reg_count, 0x35);
+
+  bms.on_mtu_negotiated_(247);
+  bms.build_dynamic_command_queue_();
+
+  ASSERT_EQ(bms.dynamic_command_queue_.size(), commands - 1);
+  EXPECT_EQ(bms.dynamic_command_queue_.back().reg_start, SEPLOS_V3_SPA1_REG_START);
+  EXPECT_EQ(bms.dynamic_command_queue_.back().reg_count, 0x6A);
+  EXPECT_EQ(bms.get_command_stats(commands - 2).requests, 0u);
+}
+
+TEST(SeplosBmsV3BleCommandQueueTest, MergedResponseIsSplitIntoBlocks) {
+  TestableSeplosBmsV3Ble bms;
+  sensor::Sensor cell_count, balancing_start_voltage;
+  bms.set_cell_count_sensor(&cell_count);
+  bms.set_balancing_start_voltage_sensor(&balancing_start_voltage);
+  bms.on_mtu_negotiated_(247);
+
+  std::vector<uint8_t> payload = SPA_DATA_1;
+  payload.insert(payload.end(), SPA_DATA_2.begin(), SPA_DATA_2.end());
+  const std::vector<uint8_t> frame = bms.make_frame(payload, 0xE0, 0x04);
+
+  bms.expect_response(SEPLOS_V3_SPA1_REG_START);
+  bms.assemble(frame.data(), frame.size());
+
+  EXPECT_FLOAT_EQ(cell_count.state, 16.0f);
+  EXPECT_NEAR(balancing_start_voltage.state, 3.400f, 0.001f);
+  EXPECT_EQ(bms.request_count_, 0);
+}
+
+TEST(SeplosBmsV3BleCommandQueueTest, LiveBlocksComeFirst) {
+  TestableSeplosBmsV3Ble bms;
+  RecordingPack pack;
+  pack.set_address(0x01);
+  bms.register_pack_component(&pack);
+  bms.build_dynamic_command_queue_();
+
+  const std::vector<uint16_t> expected = {0x2000, 0x2100, 0x2200, 0x1000, 0x1100, 0x1200,
+                                          0x1700, 0x1800, 0x1400, 0x1300, 0x1335};
+  ASSERT_EQ(bms.dynamic_command_queue_.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++)
+    EXPECT_EQ(bms.dynamic_command_queue_[i].reg_start, expected[i]) << "command " << i;
+}
+
+TEST(SeplosBmsV3BleCommandQueueTest, StaticBlocksAreRequestedLessOften) {
+  TestableSeplosBmsV3Ble bms;
+  bms.build_dynamic_command_queue_();
+  const size_t via = 3;
+  const size_t pct = 4;
+  ASSERT_EQ(bms.dynamic_command_queue_[via].reg_start, 0x1700);
+
+  for (uint32_t cycle = 0; cycle <= 60; cycle++) {
+    bms.start_poll_cycle_(cycle * 1000);
+    bms.answer_pending_requests();
+    ASSERT_FALSE(bms.polling_);
+  }
+
+  // Live data on every cycle, settings on cycle 0 and 60, the device info once
+  EXPECT_EQ(bms.get_command_stats(0).requests, 61u);
+  EXPECT_EQ(bms.get_command_stats(pct).requests, 2u);
+  EXPECT_EQ(bms.get_command_stats(via).requests, 1u);
+}
+
+TEST(SeplosBmsV3BleCommandQueueTest, UnansweredStaticBlockIsRequestedNextCycle) {
+  TestableSeplosBmsV3Ble bms;
+  bms.set_max_retries(0);
+  bms.build_dynamic_command_queue_();
+  const size_t via = 3;
+
+  // Cycle 0: everything but VIA is answered
+  bms.start_poll_cycle_(0);
+  uint32_t now = 0;
+  while (bms.polling_ && now < 100 * RESPONSE_TIMEOUT) {
+    if (bms.requests_[0].command == via) {
+      now += RESPONSE_TIMEOUT;
+      bms.check_command_timeout_(now);
+      continue;
+    }
+    const SeplosV3Request &request = bms.requests_[0];
+    const std::vector<uint8_t> frame =
+        bms.make_frame(std::vector<uint8_t>(request.byte_count, 0x00), request.device, request.function);
+    bms.assemble(frame.data(), frame.size());
+  }
+  EXPECT_FALSE(bms.command_received_[via]);
+
+  bms.check_command_timeout_(now + 1000);
+  bms.start_poll_cycle_(now + 1000);
+  bms.answer_pending_requests();
+
+  EXPECT_EQ(bms.get_command_stats(via).requests, 2u);
+  EXPECT_TRUE(bms.command_received_[via]);
+}
+
+// EIA payload reporting the given number of packs (Reg 0x2016)
+static std::vector<uint8_t> eia_with_pack_count(uint8_t pack_count) {
+  std::vector<uint8_t> data = EIA_DATA;
+  data[44] = 0x00;
+  data[45] = pack_count;
+  return data;
+}
+
+TEST(SeplosBmsV3BleCommandQueueTest, DiscoveredPacksArePolled) {
+  TestableSeplosBmsV3Ble bms;
+  RecordingPack pack;
+  pack.set_address(0x01);
+  bms.register_pack_component(&pack);
+  bms.set_auto_discover_packs(true);
+  bms.build_dynamic_command_queue_();
+  const size_t system_commands = bms.dynamic_command_queue_.size();
+
+  // No pack is polled before EIA reported the pack count
+  const std::vector<uint8_t> three_packs = bms.make_frame(eia_with_pack_count(3));
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  bms.assemble(three_packs.data(), three_packs.size());
+  ASSERT_EQ(bms.pack_count_, 3);
+
+  bms.build_dynamic_command_queue_();
+  ASSERT_EQ(bms.dynamic_command_queue_.size(), system_commands + 3 * 3);
+  EXPECT_EQ(bms.dynamic_command_queue_[3].device, 0x01);
+  EXPECT_EQ(bms.dynamic_command_queue_[9].device, 0x03);
+
+  // A removed pack stops costing round trips
+  const std::vector<uint8_t> one_pack = bms.make_frame(eia_with_pack_count(1));
+  bms.expect_response(SEPLOS_V3_EIA_REG_START);
+  bms.assemble(one_pack.data(), one_pack.size());
+  bms.build_dynamic_command_queue_();
+  EXPECT_EQ(bms.dynamic_command_queue_.size(), system_commands + 3);
+}
+
+TEST(SeplosBmsV3BleCommandQueueTest, SystemCommandsSurviveAPackCountChange) {
+  TestableSeplosBmsV3Ble bms;
+  bms.set_auto_discover_packs(true);
+  bms.pack_count_ = 1;
+  bms.build_dynamic_command_queue_();
+  bms.start_poll_cycle_(0);
+  bms.answer_pending_requests();
+  ASSERT_FALSE(bms.polling_);
+  const size_t last = bms.dynamic_command_queue_.size() - 1;
+  const SeplosV3Command static_block = bms.dynamic_command_queue_[last];
+  const uint32_t requests = bms.get_command_stats(last).requests;
+
+  bms.pack_count_ = 2;
+  bms.build_dynamic_command_queue_();
+
+  // The static blocks were read on this connection and are not requested again
+  const size_t moved = bms.dynamic_command_queue_.size() - 1;
+  ASSERT_EQ(bms.dynamic_command_queue_[moved].reg_start, static_block.reg_start);
+  EXPECT_TRUE(bms.command_received_[moved]);
+  EXPECT_EQ(bms.get_command_stats(moved).requests, requests);
+  EXPECT_EQ(bms.get_command_stats(0).responses, 1u);
+  EXPECT_FALSE(bms.command_received_[6]);
+  EXPECT_EQ(bms.get_command_stats(6).requests, 0u);
+}
+
+TEST(SeplosBmsV3BleCommandQueueTest, UnconfiguredPackIsCountedInTheStatistics) {
+  TestableSeplosBmsV3Ble bms;
+  bms.set_auto_discover_packs(true);
+  bms.pack_count_ = 2;
+  bms.build_dynamic_command_queue_();
+  const size_t pack2_pia = 6;
+  ASSERT_EQ(bms.dynamic_command_queue_[pack2_pia].device, 0x02);
+
+  bms.start_poll_cycle_(0);
+  bms.answer_pending_requests();
+
+  EXPECT_FALSE(bms.polling_);
+  EXPECT_EQ(bms.get_command_stats(pack2_pia).responses, 1u);
+}
+
+TEST(SeplosBmsV3BleCommandQueueTest, ConfiguredPacksIgnoreThePackCount) {
+  TestableSeplosBmsV3Ble bms;
+  RecordingPack pack;
+  pack.set_address(0x02);
+  bms.register_pack_component(&pack);
+  bms.build_dynamic_command_queue_();
+  const size_t commands = bms.dynamic_command_queue_.size();
+
+  bms.pack_count_ = 4;
+  bms.build_dynamic_command_queue_();
+
+  EXPECT_EQ(bms.dynamic_command_queue_.size(), commands);
+  EXPECT_EQ(bms.dynamic_command_queue_[3].device, 0x02);
+}
+
 // ── Null sensors do not crash ─────────────────────────────────────────────────
 
 TEST(SeplosBmsV3BleSafetyTest, NullSensorsDoNotCrash) {
@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include "../allocation.h"
+#include "common.h"
+#include "frames.h"
+
+namespace esphome::seplos_bms_v3_ble_pack::testing {
+
+// Allowed heap allocations per poll cycle (PIA and PIB)
+static const size_t POLL_CYCLE_ALLOCATION_BUDGET = 0;
+
+TEST(SeplosBmsV3BlePackAllocationTest, PollCycle) {
+  TestableSeplosBmsV3BlePack pack;
+  pack.set_address(0x01);
+  sensor::Sensor voltage, current, cells[16];
+  pack.set_pack_voltage_sensor(&voltage);
+  pack.set_pack_current_sensor(&current);
+  for (int i = 0; i < 16; i++)
+    pack.set_pack_cell_voltage_sensor(i, &cells[i]);
+
+  EXPECT_TRUE(allocation::within_budget("SeplosBmsV3BlePack poll cycle", POLL_CYCLE_ALLOCATION_BUDGET, [&]() {
+    pack.on_frame_data(PACK_PIA_FRAME);
+    pack.on_frame_data(PACK_PIB_FRAME);
+  }));
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+}
+
+}  // namespace esphome::seplos_bms_v3_ble_pack::testing
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include "../benchmark.h"
+#include "common.h"
+#include "frames.h"
+
+namespace esphome::seplos_bms_v3_ble_pack::testing {
+
+TEST(SeplosBmsV3BlePackBenchmark, DecodePiaFrame) {
+  TestableSeplosBmsV3BlePack pack;
+  pack.set_address(0x01);
+  sensor::Sensor voltage, current;
+  pack.set_pack_voltage_sensor(&voltage);
+  pack.set_pack_current_sensor(&current);
+
+  auto result = benchmark::run("SeplosBmsV3BlePack::on_frame_data (PIA)", PACK_PIA_FRAME.size(),
+                               [&]() { pack.on_frame_data(PACK_PIA_FRAME); });
+
+  EXPECT_GT(result.iterations, 0u);
+  EXPECT_NEAR(voltage.state, 52.80f, 0.01f);
+}
+
+TEST(SeplosBmsV3BlePackBenchmark, DecodePibFrame) {
+  TestableSeplosBmsV3BlePack pack;
+  pack.set_address(0x01);
+  sensor::Sensor cells[16];
+  for (int i = 0; i < 16; i++)
+    pack.set_pack_cell_voltage_sensor(i, &cells[i]);
+
+  auto result = benchmark::run("SeplosBmsV3BlePack::on_frame_data (PIB)", PACK_PIB_FRAME.size(),
+                               [&]() { pack.on_frame_data(PACK_PIB_FRAME); });
+
+  EXPECT_GT(result.iterations, 0u);
+  EXPECT_TRUE(cells[0].has_state());
+}
+
+}  // namespace esphome::seplos_bms_v3_ble_pack::testing
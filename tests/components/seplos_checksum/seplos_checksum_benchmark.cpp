@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../benchmark.h"
+#include "esphome/components/seplos_checksum/seplos_checksum.h"
+
+namespace esphome::seplos_checksum::testing {
+
+// Bitwise loops used by the BLE and V3 decoders before the shared checksum module
+static uint16_t crc16_xmodem_bitwise_reference(const uint8_t *data, size_t len) {
+  uint16_t crc = 0x0000;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t) data[i] << 8;
+    for (uint8_t j = 0; j < 8; j++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+static uint16_t crc16_modbus_bitwise_reference(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (uint8_t j = 0; j < 8; j++)
+      crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+  }
+  return crc;
+}
+
+// Size of a BLE v2 single machine frame
+static const size_t FRAME_SIZE = 180;
+
+static std::vector<uint8_t> make_payload() {
+  std::vector<uint8_t> data(FRAME_SIZE);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = (uint8_t) (i * 31 + 7);
+  return data;
+}
+
+// Keeps the compiler from dropping the checksum calls
+static volatile uint16_t sink;
+
+TEST(SeplosChecksumBenchmark, Crc16Xmodem) {
+  const std::vector<uint8_t> data = make_payload();
+  const uint16_t expected = crc16_xmodem_bitwise_reference(data.data(), data.size());
+
+  auto bitwise = benchmark::run("crc16_xmodem (bitwise)", data.size(),
+                                [&]() { sink = crc16_xmodem_bitwise_reference(data.data(), data.size()); });
+  auto nibble = benchmark::run("crc16_xmodem (nibble table)", data.size(), [&]() {
+    sink = crc16_xmodem_update_nibble(CRC16_XMODEM_INIT, data.data(), data.size());
+  });
+  auto table = benchmark::run("crc16_xmodem (full table)", data.size(), [&]() {
+    sink = crc16_xmodem_update_table(CRC16_XMODEM_INIT, data.data(), data.size());
+  });
+
+  EXPECT_EQ(sink, expected);
+  EXPECT_EQ(nibble.allocations_per_frame, 0.0);
+  EXPECT_EQ(table.allocations_per_frame, 0.0);
+  EXPECT_GT(bitwise.iterations, 0u);
+}
+
+TEST(SeplosChecksumBenchmark, Crc16Modbus) {
+  const std::vector<uint8_t> data = make_payload();
+  const uint16_t expected = crc16_modbus_bitwise_reference(data.data(), data.size());
+
+  auto bitwise = benchmark::run("crc16_modbus (bitwise)", data.size(),
+                                [&]() { sink = crc16_modbus_bitwise_reference(data.data(), data.size()); });
+  auto nibble = benchmark::run("crc16_modbus (nibble table)", data.size(), [&]() {
+    sink = crc16_modbus_update_nibble(CRC16_MODBUS_INIT, data.data(), data.size());
+  });
+  auto table = benchmark::run("crc16_modbus (full table)", data.size(), [&]() {
+    sink = crc16_modbus_update_table(CRC16_MODBUS_INIT, data.data(), data.size());
+  });
+
+  EXPECT_EQ(sink, expected);
+  EXPECT_EQ(nibble.allocations_per_frame, 0.0);
+  EXPECT_EQ(table.allocations_per_frame, 0.0);
+  EXPECT_GT(bitwise.iterations, 0u);
+}
+
+}  // namespace esphome::seplos_checksum::testing
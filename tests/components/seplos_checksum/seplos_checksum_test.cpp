@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "esphome/components/seplos_checksum/seplos_checksum.h"
+
+namespace esphome::seplos_checksum::testing {
+
+// Bitwise implementations the table engines replaced
+static uint16_t crc16_xmodem_bitwise(const uint8_t *data, size_t len) {
+  uint16_t crc = 0x0000;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t) data[i] << 8;
+    for (uint8_t j = 0; j < 8; j++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+static uint16_t crc16_modbus_bitwise(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (uint8_t j = 0; j < 8; j++)
+      crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+  }
+  return crc;
+}
+
+static const std::vector<uint8_t> CHECK_INPUT = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+static std::vector<uint8_t> pseudo_random_bytes(size_t length) {
+  std::vector<uint8_t> data(length);
+  uint32_t state = 0x12345678;
+  for (auto &byte : data) {
+    state = state * 1103515245 + 12345;
+    byte = state >> 16;
+  }
+  return data;
+}
+
+TEST(SeplosChecksumTest, Crc16XmodemCheckValue) {
+  EXPECT_EQ(crc16_xmodem(CHECK_INPUT.data(), CHECK_INPUT.size()), 0x31C3);
+  EXPECT_EQ(crc16_xmodem_update_nibble(CRC16_XMODEM_INIT, CHECK_INPUT.data(), CHECK_INPUT.size()), 0x31C3);
+  EXPECT_EQ(crc16_xmodem_update_table(CRC16_XMODEM_INIT, CHECK_INPUT.data(), CHECK_INPUT.size()), 0x31C3);
+}
+
+TEST(SeplosChecksumTest, Crc16ModbusCheckValue) {
+  EXPECT_EQ(crc16_modbus(CHECK_INPUT.data(), CHECK_INPUT.size()), 0x4B37);
+  EXPECT_EQ(crc16_modbus_update_nibble(CRC16_MODBUS_INIT, CHECK_INPUT.data(), CHECK_INPUT.size()), 0x4B37);
+  EXPECT_EQ(crc16_modbus_update_table(CRC16_MODBUS_INIT, CHECK_INPUT.data(), CHECK_INPUT.size()), 0x4B37);
+}
+
+TEST(SeplosChecksumTest, Crc16ModbusRequestFrame) {
+  // Read EIA (0x2000, 0x0011 registers) of device 0x00
+  const uint8_t request[] = {0x00, 0x04, 0x20, 0x00, 0x00, 0x11};
+  const uint16_t crc = crc16_modbus(request, sizeof(request));
+  EXPECT_EQ(crc, crc16_modbus_bitwise(request, sizeof(request)));
+}
+
+TEST(SeplosChecksumTest, EnginesMatchBitwiseImplementation) {
+  const std::vector<uint8_t> data = pseudo_random_bytes(512);
+  for (size_t length = 0; length <= data.size(); length += 17) {
+    const uint16_t xmodem = crc16_xmodem_bitwise(data.data(), length);
+    EXPECT_EQ(crc16_xmodem_update_nibble(CRC16_XMODEM_INIT, data.data(), length), xmodem) << "length " << length;
+    EXPECT_EQ(crc16_xmodem_update_table(CRC16_XMODEM_INIT, data.data(), length), xmodem) << "length " << length;
+
+    const uint16_t modbus = crc16_modbus_bitwise(data.data(), length);
+    EXPECT_EQ(crc16_modbus_update_nibble(CRC16_MODBUS_INIT, data.data(), length), modbus) << "length " << length;
+    EXPECT_EQ(crc16_modbus_update_table(CRC16_MODBUS_INIT, data.data(), length), modbus) << "length " << length;
+  }
+}
+
+TEST(SeplosChecksumTest, IncrementalUpdatesMatchSinglePass) {
+  const std::vector<uint8_t> data = pseudo_random_bytes(300);
+  const uint16_t xmodem = crc16_xmodem(data.data(), data.size());
+  const uint16_t modbus = crc16_modbus(data.data(), data.size());
+
+  // BLE notifications arrive in chunks of up to 20 bytes (or the negotiated MTU)
+  for (size_t chunk : {1, 7, 20, 244}) {
+    uint16_t xmodem_crc = CRC16_XMODEM_INIT;
+    uint16_t modbus_crc = CRC16_MODBUS_INIT;
+    for (size_t pos = 0; pos < data.size(); pos += chunk) {
+      const size_t length = std::min(chunk, data.size() - pos);
+      xmodem_crc = crc16_xmodem_update(xmodem_crc, data.data() + pos, length);
+      modbus_crc = crc16_modbus_update(modbus_crc, data.data() + pos, length);
+    }
+    EXPECT_EQ(xmodem_crc, xmodem) << "chunk " << chunk;
+    EXPECT_EQ(modbus_crc, modbus) << "chunk " << chunk;
+  }
+}
+
+TEST(SeplosChecksumTest, Sum16MatchesRecordedFrame) {
+  // ASCII part of "~20004642E00200FD37\r"
+  const std::string payload = "20004642E00200";
+  const uint16_t sum = sum16_update(0, reinterpret_cast<const uint8_t *>(payload.data()), payload.size());
+  EXPECT_EQ(sum16_finalize(sum), 0xFD37);
+
+  // Split updates
+  uint16_t split = sum16_update(0, reinterpret_cast<const uint8_t *>(payload.data()), 5);
+  split = sum16_update(split, reinterpret_cast<const uint8_t *>(payload.data()) + 5, payload.size() - 5);
+  EXPECT_EQ(sum16_finalize(split), 0xFD37);
+}
+
+}  // namespace esphome::seplos_checksum::testing
@@ -24,18 +24,20 @@ static std::vector<uint8_t> make_seplos_frame(const std::string &ascii_payload)
   return frame;
 }
 
-// VER=0x20, ADDR=0x00, CID1=0x46, CID2=0x00 -> decoded address=0x00
-static const std::vector<uint8_t> FRAME_ADDR_00 = make_seplos_frame("20004600");
-// VER=0x20, ADDR=0x01, CID1=0x46, CID2=0x00 -> decoded address=0x01
-static const std::vector<uint8_t> FRAME_ADDR_01 = make_seplos_frame("20014600");
+// VER=0x20, ADDR=0x00, CID1=0x46, CID2=0x00, LENGTH=0x0000 -> decoded address=0x00
+static const std::vector<uint8_t> FRAME_ADDR_00 = make_seplos_frame("200046000000");
+// VER=0x20, ADDR=0x01, CID1=0x46, CID2=0x00, LENGTH=0x0000 -> decoded address=0x01
+static const std::vector<uint8_t> FRAME_ADDR_01 = make_seplos_frame("200146000000");
 
 class MockSeplosModbusDevice : public SeplosModbusDevice {
  public:
   std::vector<uint8_t> received_data;
+  uint8_t received_function{0xFF};
   int call_count{0};
 
-  void on_seplos_modbus_data(const std::vector<uint8_t> &data) override {
-    received_data = data;
+  void on_seplos_modbus_data(uint8_t function, const uint8_t *data, uint16_t length) override {
+    received_function = function;
+    received_data.assign(data, data + length);
     call_count++;
   }
 };
@@ -44,13 +46,24 @@ class TestableSeplosModbus : public SeplosModbus {
  public:
   void loop() override {}
   using SeplosModbus::parse_seplos_modbus_byte_;
+  using SeplosModbus::process_request_queue_;
+  using SeplosModbus::current_turnaround_gap_;
+  using SeplosModbus::pending_request_;
+  using SeplosModbus::queue_;
+  using SeplosModbus::queue_size_;
+  using SeplosModbus::waiting_for_response_;
+  using SeplosModbus::last_send_;
+  using SeplosModbus::check_transmission_;
+  using SeplosModbus::transmitting_;
+  using SeplosModbus::tx_start_;
+  using SeplosModbus::tx_duration_;
 
   bool feed(const std::vector<uint8_t> &frame) {
     bool result = false;
     for (uint8_t byte : frame) {
       result = parse_seplos_modbus_byte_(byte);
       if (!result)
-        rx_buffer_.clear();
+        reset_rx_buffer_();
     }
     return result;
   }
@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+#include "../allocation.h"
+#include "common.h"
+
+namespace esphome::seplos_modbus::testing {
+
+TEST(SeplosModbusAllocationTest, PollCycle) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_parent(&modbus);
+  device.set_address(0x00);
+  device.set_protocol_version(0x20);
+  modbus.register_device(&device);
+
+  // Request (encoded once and cached) and response
+  EXPECT_TRUE(allocation::within_budget("SeplosModbus poll cycle", 0, [&]() {
+    device.send(0x42, 0x00);
+    modbus.queue_size_ = 0;
+    modbus.feed(FRAME_ADDR_00);
+  }));
+  EXPECT_EQ(device.call_count, 2);
+}
+
+}  // namespace esphome::seplos_modbus::testing
@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+#include "../benchmark.h"
+#include "common.h"
+
+namespace esphome::seplos_modbus::testing {
+
+// Telemetry response of a 16 cell pack (see README)
+static const std::vector<uint8_t> TELEMETRY_RESPONSE = make_seplos_frame(
+    "2000460010960001100CD70CE90CF40CD60CEF0CE50CE10CDC0CE90CF00CE80CEF0CEA0CDA0CDE0CD8060BA60BA00B970BA60BA50BA2FD5C"
+    "14A0344E0A426803134650004603E8149F0000000000000000");
+
+TEST(SeplosModbusBenchmark, ParseTelemetryFrame) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x00);
+  modbus.register_device(&device);
+
+  auto result = benchmark::run("SeplosModbus::parse_seplos_modbus_byte_", TELEMETRY_RESPONSE.size(),
+                               [&]() { modbus.feed(TELEMETRY_RESPONSE); });
+
+  EXPECT_GT(result.iterations, 0u);
+  EXPECT_EQ(device.received_data.size(), 81u);
+}
+
+}  // namespace esphome::seplos_modbus::testing
@@ -22,12 +22,14 @@ TEST(SeplosModbusTest, FrameDataDecodedCorrectly) {
 
   modbus.feed(FRAME_ADDR_00);
 
-  // ASCII "20004600" decodes to [0x20, 0x00, 0x46, 0x00]
-  ASSERT_EQ(device.received_data.size(), 4u);
+  // ASCII "200046000000" decodes to [0x20, 0x00, 0x46, 0x00] followed by the LENGTH field [0x00, 0x00]
+  ASSERT_EQ(device.received_data.size(), 6u);
   EXPECT_EQ(device.received_data[0], 0x20);
   EXPECT_EQ(device.received_data[1], 0x00);
   EXPECT_EQ(device.received_data[2], 0x46);
   EXPECT_EQ(device.received_data[3], 0x00);
+  EXPECT_EQ(device.received_data[4], 0x00);
+  EXPECT_EQ(device.received_data[5], 0x00);
 }
 
 TEST(SeplosModbusTest, TwoFramesDispatchedTwice) {
@@ -109,4 +111,360 @@ TEST(SeplosModbusTest, AddressMatchSelectsCorrectDevice) {
   EXPECT_EQ(device_01.call_count, 1);
 }
 
+TEST(SeplosModbusTest, LowercaseHexDecoded) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x0a);
+  modbus.register_device(&device);
+
+  modbus.feed(make_seplos_frame("200a46ff0000"));
+
+  ASSERT_EQ(device.call_count, 1);
+  ASSERT_EQ(device.received_data.size(), 6u);
+  EXPECT_EQ(device.received_data[1], 0x0a);
+  EXPECT_EQ(device.received_data[3], 0xff);
+}
+
+TEST(SeplosModbusTest, InvalidCharacterRejected) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x00);
+  modbus.register_device(&device);
+
+  modbus.feed(make_seplos_frame("2000460G0000"));
+
+  EXPECT_EQ(device.call_count, 0);
+}
+
+TEST(SeplosModbusTest, OddCharacterCountRejected) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x00);
+  modbus.register_device(&device);
+
+  // LENGTH announces 2 INFO characters but only 1 is sent
+  modbus.feed(make_seplos_frame("20004600E0020"));
+
+  EXPECT_EQ(device.call_count, 0);
+}
+
+TEST(SeplosModbusTest, OversizedFrameRejected) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x00);
+  modbus.register_device(&device);
+
+  // LENID=0x150 -> 12 + 336 + 4 characters
+  modbus.feed(make_seplos_frame("20004600A150" + std::string(0x150, '0')));
+  EXPECT_EQ(device.call_count, 0);
+
+  modbus.feed(FRAME_ADDR_00);
+  EXPECT_EQ(device.call_count, 1);
+}
+
+TEST(SeplosModbusTest, DuplicateRequestsAreQueuedOnce) {
+  TestableSeplosModbus modbus;
+
+  uint8_t frame_00[REQUEST_FRAME_SIZE];
+  uint8_t frame_01[REQUEST_FRAME_SIZE];
+
+  EXPECT_TRUE(modbus.queue_request(0x00, 0x42, frame_00, REQUEST_FRAME_SIZE));
+  EXPECT_TRUE(modbus.queue_request(0x00, 0x42, frame_00, REQUEST_FRAME_SIZE));
+  EXPECT_TRUE(modbus.queue_request(0x01, 0x42, frame_01, REQUEST_FRAME_SIZE));
+
+  EXPECT_EQ(modbus.queue_size_, 2);
+}
+
+TEST(SeplosModbusTest, FullQueueRejectsRequest) {
+  TestableSeplosModbus modbus;
+
+  uint8_t frames[MAX_QUEUED_REQUESTS + 1][REQUEST_FRAME_SIZE];
+
+  for (uint8_t i = 0; i < MAX_QUEUED_REQUESTS; i++)
+    EXPECT_TRUE(modbus.queue_request(i, 0x42, frames[i], REQUEST_FRAME_SIZE));
+
+  EXPECT_FALSE(modbus.queue_request(0xFF, 0x42, frames[MAX_QUEUED_REQUESTS], REQUEST_FRAME_SIZE));
+  EXPECT_EQ(modbus.queue_size_, MAX_QUEUED_REQUESTS);
+}
+
+TEST(SeplosModbusTest, ResponseCompletesPendingRequest) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x00);
+  modbus.register_device(&device);
+  modbus.pending_request_.address = 0x00;
+  modbus.pending_request_.function = 0x44;
+  modbus.waiting_for_response_ = true;
+
+  modbus.feed(FRAME_ADDR_00);
+
+  EXPECT_FALSE(modbus.waiting_for_response_);
+  EXPECT_EQ(device.call_count, 1);
+  EXPECT_EQ(device.received_function, 0x44);
+}
+
+TEST(SeplosModbusTest, UnsolicitedFrameHasNoFunction) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x01);
+  modbus.register_device(&device);
+  modbus.pending_request_.address = 0x00;
+  modbus.pending_request_.function = 0x42;
+  modbus.waiting_for_response_ = true;
+
+  modbus.feed(FRAME_ADDR_01);
+
+  EXPECT_EQ(device.call_count, 1);
+  EXPECT_EQ(device.received_function, 0x00);
+}
+
+TEST(SeplosModbusTest, ResponseFromOtherAddressKeepsRequestPending) {
+  TestableSeplosModbus modbus;
+  modbus.pending_request_.address = 0x00;
+  modbus.waiting_for_response_ = true;
+
+  modbus.feed(FRAME_ADDR_01);
+
+  EXPECT_TRUE(modbus.waiting_for_response_);
+}
+
+TEST(SeplosModbusTest, ResponseTimeoutReleasesBusAndBacksOff) {
+  TestableSeplosModbus modbus;
+  modbus.set_response_timeout(100);
+  modbus.set_turnaround_gap(50);
+  modbus.waiting_for_response_ = true;
+  modbus.last_send_ = 1000;
+
+  modbus.process_request_queue_(1050);
+  EXPECT_TRUE(modbus.waiting_for_response_);
+
+  modbus.process_request_queue_(1100);
+  EXPECT_FALSE(modbus.waiting_for_response_);
+  EXPECT_EQ(modbus.current_turnaround_gap_, 100);
+}
+
+TEST(SeplosModbusTest, SuccessfulResponseShrinksTurnaroundGap) {
+  TestableSeplosModbus modbus;
+  modbus.set_turnaround_gap(50);
+  modbus.current_turnaround_gap_ = 400;
+  modbus.pending_request_.address = 0x00;
+  modbus.waiting_for_response_ = true;
+
+  modbus.feed(FRAME_ADDR_00);
+  EXPECT_EQ(modbus.current_turnaround_gap_, 200);
+
+  modbus.current_turnaround_gap_ = 60;
+  modbus.waiting_for_response_ = true;
+  modbus.feed(FRAME_ADDR_00);
+  EXPECT_EQ(modbus.current_turnaround_gap_, 50);
+}
+
+TEST(SeplosModbusTest, RequestDeferredWhileReceiving) {
+  TestableSeplosModbus modbus;
+  uint8_t frame[REQUEST_FRAME_SIZE];
+  modbus.queue_request(0x00, 0x42, frame, REQUEST_FRAME_SIZE);
+
+  modbus.parse_seplos_modbus_byte_(0x7E);
+  modbus.process_request_queue_(100000);
+
+  EXPECT_EQ(modbus.queue_size_, 1);
+  EXPECT_FALSE(modbus.waiting_for_response_);
+}
+
+TEST(SeplosModbusTest, FrameWithInfoDecoded) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x00);
+  modbus.register_device(&device);
+
+  modbus.feed(make_seplos_frame("20004642E00200"));
+
+  ASSERT_EQ(device.call_count, 1);
+  ASSERT_EQ(device.received_data.size(), 7u);
+  EXPECT_EQ(device.received_data[3], 0x42);
+  EXPECT_EQ(device.received_data[6], 0x00);
+}
+
+TEST(SeplosModbusTest, FrameCompletedByLengthWithoutEoi) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x00);
+  modbus.register_device(&device);
+
+  std::vector<uint8_t> frame(FRAME_ADDR_00.begin(), FRAME_ADDR_00.end() - 1);
+  modbus.feed(frame);
+
+  EXPECT_EQ(device.call_count, 1);
+}
+
+TEST(SeplosModbusTest, InvalidLengthChecksumRejected) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x00);
+  modbus.register_device(&device);
+
+  modbus.feed(make_seplos_frame("20004642F00200"));
+
+  EXPECT_EQ(device.call_count, 0);
+}
+
+TEST(SeplosModbusTest, ResyncOnStartOfFrameInsideFrame) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x01);
+  modbus.register_device(&device);
+
+  std::vector<uint8_t> stream(FRAME_ADDR_00.begin(), FRAME_ADDR_00.begin() + 8);
+  stream.insert(stream.end(), FRAME_ADDR_01.begin(), FRAME_ADDR_01.end());
+  modbus.feed(stream);
+
+  EXPECT_EQ(device.call_count, 1);
+}
+
+TEST(SeplosModbusTest, NoiseBetweenFramesSkipped) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x00);
+  modbus.register_device(&device);
+
+  std::vector<uint8_t> stream = {0x00, 0xFF, 0x0D, 0x41};
+  stream.insert(stream.end(), FRAME_ADDR_00.begin(), FRAME_ADDR_00.end());
+  stream.insert(stream.end(), {0x55, 0xAA});
+  stream.insert(stream.end(), FRAME_ADDR_00.begin(), FRAME_ADDR_00.end());
+  modbus.feed(stream);
+
+  EXPECT_EQ(device.call_count, 2);
+}
+
+TEST(SeplosModbusTest, EncodeRequestFrame) {
+  uint8_t frame[REQUEST_FRAME_SIZE];
+  uint8_t value = 0x00;
+  uint8_t length;
+
+  length = encode_request_frame(0x20, 0x00, 0x42, &value, 1, frame);
+  EXPECT_EQ(std::string(frame, frame + length), "~20004642E00200FD37\r");
+
+  value = 0x01;
+  length = encode_request_frame(0x20, 0x01, 0x42, &value, 1, frame);
+  EXPECT_EQ(std::string(frame, frame + length), "~20014642E00201FD35\r");
+}
+
+TEST(SeplosModbusTest, EncodeRequestFrameWithoutInfo) {
+  uint8_t frame[REQUEST_FRAME_SIZE];
+  uint8_t length;
+
+  length = encode_request_frame(0x20, 0x00, 0x47, nullptr, 0, frame);
+  EXPECT_EQ(std::string(frame, frame + length), "~200046470000FDA9\r");
+
+  length = encode_request_frame(0x20, 0x00, 0x4F, nullptr, 0, frame);
+  EXPECT_EQ(std::string(frame, frame + length), "~2000464F0000FD9A\r");
+
+  length = encode_request_frame(0x20, 0x00, 0x51, nullptr, 0, frame);
+  EXPECT_EQ(std::string(frame, frame + length), "~200046510000FDAE\r");
+}
+
+TEST(SeplosModbusTest, DeviceEncodesRequestOnce) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_parent(&modbus);
+  device.set_address(0x00);
+  device.set_protocol_version(0x20);
+
+  device.send(0x42, 0x00);
+  const uint8_t *frame = modbus.queue_[0].frame;
+  modbus.queue_size_ = 0;
+  device.send(0x42, 0x00);
+
+  EXPECT_EQ(modbus.queue_[0].frame, frame);
+  EXPECT_EQ(std::string(frame, frame + modbus.queue_[0].frame_length), "~20004642E00200FD37\r");
+
+  modbus.queue_size_ = 0;
+  device.send(0x51);
+
+  EXPECT_NE(modbus.queue_[0].frame, frame);
+  EXPECT_EQ(modbus.queue_[0].function, 0x51);
+  EXPECT_EQ(std::string(modbus.queue_[0].frame, modbus.queue_[0].frame + modbus.queue_[0].frame_length),
+            "~200046510000FDAE\r");
+}
+
+TEST(SeplosModbusTest, MultipleConsumersPerAddress) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device_a, device_b, device_c;
+  device_a.set_address(0x00);
+  device_b.set_address(0x01);
+  device_c.set_address(0x00);
+  modbus.register_device(&device_a);
+  modbus.register_device(&device_b);
+  modbus.register_device(&device_c);
+
+  modbus.feed(FRAME_ADDR_00);
+
+  EXPECT_EQ(device_a.call_count, 1);
+  EXPECT_EQ(device_b.call_count, 0);
+  EXPECT_EQ(device_c.call_count, 1);
+}
+
+TEST(SeplosModbusTest, UnknownAddressFramesCounted) {
+  TestableSeplosModbus modbus;
+  MockSeplosModbusDevice device;
+  device.set_address(0x01);
+  modbus.register_device(&device);
+
+  modbus.feed(FRAME_ADDR_00);
+  modbus.feed(FRAME_ADDR_01);
+  modbus.feed(FRAME_ADDR_00);
+
+  EXPECT_EQ(modbus.get_unknown_address_frames(), 2u);
+  EXPECT_EQ(device.call_count, 1);
+}
+
+TEST(SeplosModbusTest, TransmissionCompletesAfterFrameAndGuardTime) {
+  TestableSeplosModbus modbus;
+  modbus.set_guard_time(500);
+  modbus.tx_duration_ = 20000;
+  modbus.tx_start_ = 1000;
+  modbus.transmitting_ = true;
+
+  modbus.check_transmission_(21499);
+  EXPECT_TRUE(modbus.transmitting_);
+
+  modbus.check_transmission_(21500);
+  EXPECT_FALSE(modbus.transmitting_);
+}
+
+TEST(SeplosModbusTest, TransmissionWithGuardTimeDoesNotBlock) {
+  TestableSeplosModbus modbus;
+  modbus.set_guard_time(500);
+  modbus.queue_request(0x00, 0x42, FRAME_ADDR_00.data(), FRAME_ADDR_00.size());
+
+  modbus.process_request_queue_(1000);
+
+  EXPECT_TRUE(modbus.transmitting_);
+  EXPECT_EQ(modbus.flushes, 0);
+}
+
+TEST(SeplosModbusTest, TransmissionWithoutGuardTimeWaitsForTheFrame) {
+  TestableSeplosModbus modbus;
+  modbus.set_guard_time(0);
+  modbus.queue_request(0x00, 0x42, FRAME_ADDR_00.data(), FRAME_ADDR_00.size());
+
+  modbus.process_request_queue_(1000);
+
+  EXPECT_FALSE(modbus.transmitting_);
+  EXPECT_EQ(modbus.flushes, 1);
+  EXPECT_TRUE(modbus.waiting_for_response_);
+}
+
+TEST(SeplosModbusTest, ResponseDeadlineSuspendedWhileTransmitting) {
+  TestableSeplosModbus modbus;
+  modbus.set_response_timeout(100);
+  modbus.waiting_for_response_ = true;
+  modbus.transmitting_ = true;
+  modbus.last_send_ = 0;
+
+  modbus.process_request_queue_(5000);
+
+  EXPECT_TRUE(modbus.waiting_for_response_);
+}
+
 }  // namespace esphome::seplos_modbus::testing
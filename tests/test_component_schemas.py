@@ -45,7 +45,7 @@ class TestSeplosBmsSensorLists:
     def test_sensor_defs_completeness(self):
         assert "total_voltage" in sensor.SENSOR_DEFS
         assert "state_of_charge" in sensor.SENSOR_DEFS
-        assert len(sensor.SENSOR_DEFS) == 18
+        assert len(sensor.SENSOR_DEFS) == 28
 
     def test_no_cell_keys_in_sensor_defs(self):
         for key in sensor.SENSOR_DEFS:
@@ -56,13 +56,17 @@ class TestSeplosBmsSensorLists:
 class TestSeplosBmsBinarySensorConstants:
     def test_binary_sensor_defs_dict(self):
         assert binary_sensor.CONF_ONLINE_STATUS in binary_sensor.BINARY_SENSOR_DEFS
-        assert len(binary_sensor.BINARY_SENSOR_DEFS) == 1
+        assert len(binary_sensor.BINARY_SENSOR_DEFS) == 4
 
 
 class TestSeplosBmsTextSensorConstants:
     def test_text_sensors_list(self):
         assert text_sensor.CONF_ERRORS in text_sensor.TEXT_SENSORS
-        assert len(text_sensor.TEXT_SENSORS) == 1
+        assert text_sensor.CONF_PROTOCOL_VERSION in text_sensor.TEXT_SENSORS
+        assert text_sensor.CONF_DEVICE_MODEL in text_sensor.TEXT_SENSORS
+        assert text_sensor.CONF_SOFTWARE_VERSION in text_sensor.TEXT_SENSORS
+        assert text_sensor.CONF_MANUFACTURER in text_sensor.TEXT_SENSORS
+        assert len(text_sensor.TEXT_SENSORS) == 5
 
 
 class TestSeplosBmsBleSensorLists:
@@ -85,6 +89,16 @@ class TestSeplosBmsBleSensorLists:
             assert key not in ble_sensor.CELLS
             assert key not in ble_sensor.TEMPERATURES
 
+    def test_settings_count(self):
+        # Must match SEPLOS_SETTINGS_COUNT of the settings descriptor table
+        assert len(ble_sensor.SETTINGS) == 66
+        assert list(ble_sensor.SETTINGS)[0] == "cell_high_voltage_alarm"
+        assert list(ble_sensor.SETTINGS)[-1] == "cells_in_series"
+
+    def test_no_setting_keys_in_sensor_defs(self):
+        for key in ble_sensor.SETTINGS:
+            assert key not in ble_sensor.SENSOR_DEFS
+
 
 class TestSeplosBmsBleBinarySensorConstants:
     def test_binary_sensor_defs_dict(self):